@@ -0,0 +1,166 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "Event.hpp"
+#include "IEventHandler.hpp"
+#include "MpscQueue.hpp"
+
+// Puts a bounded lock-free inbox in front of another handler. receive() may be called from any
+// number of threads; the wrapped handler is fed by a single consumer thread owned by the adapter.
+class AsyncEventHandler : public IEventHandler
+{
+public:
+    enum class Backpressure
+    {
+        Block,      // wait for room
+        DropOldest, // evict the oldest queued event
+        Reject      // discard the incoming event
+    };
+
+    struct Stats
+    {
+        std::size_t depth;
+        std::uint64_t enqueued;
+        std::uint64_t dropped;
+        std::uint64_t rejected;
+        std::uint64_t failures;
+        std::uint64_t enqueueNanosTotal;
+        std::uint64_t enqueueNanosMax;
+    };
+
+    AsyncEventHandler(IEventHandler& p_handler, std::size_t p_capacity, Backpressure p_backpressure = Backpressure::Block)
+        : m_handler(p_handler),
+          m_backpressure(p_backpressure),
+          m_queue(p_capacity),
+          m_consumer(&AsyncEventHandler::consume, this)
+    {}
+
+    // Delivers everything already queued before returning.
+    ~AsyncEventHandler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+            m_stopping = true;
+        }
+        m_wakeUp.notify_one();
+        m_consumer.join();
+    }
+
+    AsyncEventHandler(AsyncEventHandler const&) = delete;
+    AsyncEventHandler& operator=(AsyncEventHandler const&) = delete;
+
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        auto const start = std::chrono::steady_clock::now();
+
+        while (not m_queue.tryPush(p_event)) {
+            if (m_backpressure == Backpressure::Reject) {
+                m_rejected.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (m_backpressure == Backpressure::DropOldest) {
+                std::unique_ptr<Event> oldest;
+                if (m_queue.tryPop(oldest)) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        m_enqueued.fetch_add(1, std::memory_order_relaxed);
+        recordEnqueueLatency(std::chrono::steady_clock::now() - start);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_consumerSleeping.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(m_wakeUpMutex);
+            m_wakeUp.notify_one();
+        }
+    }
+
+    Stats stats() const
+    {
+        return Stats{
+            m_queue.size(),
+            m_enqueued.load(std::memory_order_relaxed),
+            m_dropped.load(std::memory_order_relaxed),
+            m_rejected.load(std::memory_order_relaxed),
+            m_failures.load(std::memory_order_relaxed),
+            m_enqueueNanosTotal.load(std::memory_order_relaxed),
+            m_enqueueNanosMax.load(std::memory_order_relaxed)};
+    }
+
+private:
+    static constexpr int SPINS_BEFORE_SLEEP = 64;
+
+    void recordEnqueueLatency(std::chrono::steady_clock::duration p_latency) noexcept
+    {
+        auto const nanos = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(p_latency).count());
+
+        m_enqueueNanosTotal.fetch_add(nanos, std::memory_order_relaxed);
+        auto max = m_enqueueNanosMax.load(std::memory_order_relaxed);
+        while (nanos > max and not m_enqueueNanosMax.compare_exchange_weak(max, nanos, std::memory_order_relaxed)) {}
+    }
+
+    void consume()
+    {
+        int idleSpins = 0;
+        std::unique_ptr<Event> event;
+
+        while (true) {
+            if (m_queue.tryPop(event)) {
+                idleSpins = 0;
+                try {
+                    m_handler.receive(std::move(event));
+                } catch (std::exception const&) {
+                    m_failures.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+
+            if (m_stopping.load() and m_queue.size() == 0) {
+                return;
+            }
+
+            if (++idleSpins < SPINS_BEFORE_SLEEP) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+            m_consumerSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            m_wakeUp.wait(lock, [this] { return m_stopping.load() or m_queue.size() > 0; });
+            m_consumerSleeping.store(false, std::memory_order_relaxed);
+            idleSpins = 0;
+        }
+    }
+
+    IEventHandler& m_handler;
+    Backpressure const m_backpressure;
+    MpscQueue<std::unique_ptr<Event>> m_queue;
+
+    std::atomic<std::uint64_t> m_enqueued{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_rejected{0};
+    std::atomic<std::uint64_t> m_failures{0};
+    std::atomic<std::uint64_t> m_enqueueNanosTotal{0};
+    std::atomic<std::uint64_t> m_enqueueNanosMax{0};
+
+    std::atomic<bool> m_stopping{false};
+    std::atomic<bool> m_consumerSleeping{false};
+    std::mutex m_wakeUpMutex;
+    std::condition_variable m_wakeUp;
+
+    std::thread m_consumer;
+};
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
+#ifdef DYNAMIC_EVENTS_POOL
+#include "EventPool.hpp"
+#endif
+
 class Event
 {
 public:
@@ -10,4 +15,14 @@ public:
 
     virtual std::uint32_t getMessageId() const = 0;
     virtual std::unique_ptr<Event> clone() const  = 0;
+
+    // Gives up this event's payload to an event whose clones all share it; for fanning out one
+    // event to many receivers. Events that cannot share hand out a clone instead.
+    virtual std::unique_ptr<Event> share() { return clone(); }
+
+#ifdef DYNAMIC_EVENTS_POOL
+    // The virtual destructor makes std::default_delete<Event> return the block with the dynamic size.
+    static void* operator new(std::size_t p_size) { return EventPool::allocate(p_size); }
+    static void operator delete(void* p_block, std::size_t p_size) noexcept { EventPool::deallocate(p_block, p_size); }
+#endif
 };
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "EventT.hpp"
+
+// Turns events into bytes and back, keyed by MESSAGE_ID. Payloads that are trivially copyable
+// can be registered with add<T>(); anything else needs its own encoder and decoder.
+class EventCodecRegistry
+{
+public:
+    using Encoder = void (*)(Event const&, std::vector<std::uint8_t>&);
+    using Decoder = std::unique_ptr<Event> (*)(std::uint8_t const*, std::size_t);
+    using Writer = void (*)(Event const&, std::uint8_t*);
+
+    static constexpr std::size_t VARIABLE_SIZE = SIZE_MAX;
+
+    template <class T>
+    void add()
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Register an explicit codec for this payload!");
+        m_codecs[T::MESSAGE_ID] = Codec{&encodeTrivial<T>, &decodeTrivial<T>, trivialSize<T>(), &writeTrivial<T>};
+    }
+
+    void add(std::uint32_t p_messageId, Encoder p_encoder, Decoder p_decoder)
+    {
+        m_codecs[p_messageId] = Codec{p_encoder, p_decoder, VARIABLE_SIZE, nullptr};
+    }
+
+    bool knows(std::uint32_t p_messageId) const { return m_codecs.count(p_messageId) != 0; }
+
+    // Replaces the contents of p_bytes with the encoded payload.
+    void encode(Event const& p_event, std::vector<std::uint8_t>& p_bytes) const
+    {
+        p_bytes.clear();
+        find(p_event.getMessageId()).encode(p_event, p_bytes);
+    }
+
+    // Adds the encoded payload at the end of p_bytes, keeping what is already there.
+    void append(Event const& p_event, std::vector<std::uint8_t>& p_bytes) const
+    {
+        find(p_event.getMessageId()).encode(p_event, p_bytes);
+    }
+
+    // Encoded size shared by all p_messageId events, known for payloads registered with add<T>();
+    // VARIABLE_SIZE for the others.
+    std::size_t fixedSize(std::uint32_t p_messageId) const { return find(p_messageId).fixedSize; }
+
+    // Encodes straight into p_destination, which has room for fixedSize() bytes. Only for
+    // messages of a fixed size.
+    void encodeInPlace(Event const& p_event, std::uint8_t* p_destination) const
+    {
+        auto const& codec = find(p_event.getMessageId());
+        if (not codec.write) {
+            throw std::invalid_argument("Message " + std::to_string(p_event.getMessageId()) + " has no fixed size");
+        }
+        codec.write(p_event, p_destination);
+    }
+
+    std::unique_ptr<Event> decode(std::uint32_t p_messageId, std::uint8_t const* p_bytes, std::size_t p_size) const
+    {
+        return find(p_messageId).decode(p_bytes, p_size);
+    }
+
+    template <class T>
+    static constexpr std::size_t trivialSize() noexcept { return std::is_empty<T>::value ? 0 : sizeof(T); }
+
+private:
+    struct Codec
+    {
+        Encoder encode;
+        Decoder decode;
+        std::size_t fixedSize;
+        Writer write;
+    };
+
+    Codec const& find(std::uint32_t p_messageId) const
+    {
+        auto const codec = m_codecs.find(p_messageId);
+        if (codec == m_codecs.end()) {
+            throw std::invalid_argument("No codec registered for message " + std::to_string(p_messageId));
+        }
+        return codec->second;
+    }
+
+    template <class T>
+    static void encodeTrivial(Event const& p_event, std::vector<std::uint8_t>& p_bytes)
+    {
+        auto const& value = payload<T>(p_event);
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(&value);
+        p_bytes.insert(p_bytes.end(), bytes, bytes + trivialSize<T>());
+    }
+
+    template <class T>
+    static void writeTrivial(Event const& p_event, std::uint8_t* p_destination)
+    {
+        if (trivialSize<T>()) {
+            std::memcpy(p_destination, &payload<T>(p_event), trivialSize<T>());
+        }
+    }
+
+    template <class T>
+    static std::unique_ptr<Event> decodeTrivial(std::uint8_t const* p_bytes, std::size_t p_size)
+    {
+        if (p_size != trivialSize<T>()) {
+            throw std::invalid_argument("Payload size does not match message " + std::to_string(T::MESSAGE_ID));
+        }
+        auto event = std::make_unique<EventT<T>>();
+        if (p_size) {
+            std::memcpy(&**event, p_bytes, p_size);
+        }
+        return event;
+    }
+
+    std::unordered_map<std::uint32_t, Codec> m_codecs;
+};
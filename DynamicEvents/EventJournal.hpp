@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Event.hpp"
+#include "EventCodecRegistry.hpp"
+#include "IEventHandler.hpp"
+#include "IPort.hpp"
+#include "MappedFile.hpp"
+
+// Append-only event journal in a memory-mapped file made of 32-byte records. The first record is
+// the file header. Each event starts with a header record carrying its sequence number, channel,
+// MESSAGE_ID and the first 12 payload bytes; longer payloads continue in the following records, so
+// every payload is contiguous in the file and can be decoded in place.
+struct JournalFileHeader
+{
+    static constexpr char MAGIC[4] = {'E', 'V', 'J', 'R'};
+    static constexpr std::uint32_t VERSION = 2;
+
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint32_t reserved;
+    std::uint64_t records; // committed records, header included
+    std::uint64_t events;
+};
+
+struct JournalRecord
+{
+    static constexpr std::size_t INLINE_PAYLOAD = 12;
+
+    std::uint64_t sequence;
+    std::uint32_t messageId;
+    std::uint32_t payloadSize;
+    std::uint8_t channel;
+    std::uint8_t reserved[3];
+    std::uint8_t payload[INLINE_PAYLOAD];
+
+    static std::size_t recordsFor(std::size_t p_payloadSize) noexcept
+    {
+        return p_payloadSize <= INLINE_PAYLOAD
+            ? 1
+            : 1 + (p_payloadSize - INLINE_PAYLOAD + sizeof(JournalRecord) - 1) / sizeof(JournalRecord);
+    }
+};
+
+static_assert(sizeof(JournalFileHeader) == 32 and sizeof(JournalRecord) == 32, "Journal records are 32 bytes");
+
+// Channel 0 is reserved for events entering the journaled handler; ports use channels 1 to 255.
+constexpr std::uint8_t JOURNAL_INPUT_CHANNEL = 0;
+
+// Not thread-safe: all journaled handlers and ports must run on one thread.
+class EventJournal
+{
+public:
+    EventJournal(std::string const& p_path, EventCodecRegistry const& p_codecs, std::size_t p_initialRecords = 1 << 16)
+        : m_codecs(p_codecs),
+          m_file(MappedFile::create(p_path, (p_initialRecords + 1) * sizeof(JournalRecord)))
+    {
+        JournalFileHeader header{};
+        std::memcpy(header.magic, JournalFileHeader::MAGIC, sizeof(header.magic));
+        header.version = JournalFileHeader::VERSION;
+        header.recordSize = sizeof(JournalRecord);
+        header.records = 1;
+        std::memcpy(m_file.data(), &header, sizeof(header));
+        m_records = 1;
+    }
+
+    // Trims the file to the records actually written.
+    ~EventJournal()
+    {
+        try {
+            m_file.resize(m_records * sizeof(JournalRecord));
+        } catch (...) {}
+    }
+
+    EventJournal(EventJournal const&) = delete;
+    EventJournal& operator=(EventJournal const&) = delete;
+
+    void append(std::uint8_t p_channel, Event const& p_event)
+    {
+        m_codecs.encode(p_event, m_scratch);
+        if (m_scratch.size() > UINT32_MAX) {
+            throw std::length_error("Event payload too large for the journal");
+        }
+
+        auto const needed = JournalRecord::recordsFor(m_scratch.size());
+        if ((m_records + needed) * sizeof(JournalRecord) > m_file.size()) {
+            m_file.resize(std::max(m_file.size() * 2, (m_records + needed) * sizeof(JournalRecord)));
+        }
+
+        JournalRecord record{};
+        record.sequence = m_events;
+        record.messageId = p_event.getMessageId();
+        record.payloadSize = static_cast<std::uint32_t>(m_scratch.size());
+        record.channel = p_channel;
+
+        auto const destination = m_file.data() + m_records * sizeof(JournalRecord);
+        std::memcpy(destination, &record, offsetof(JournalRecord, payload));
+        if (not m_scratch.empty()) {
+            std::memcpy(destination + offsetof(JournalRecord, payload), m_scratch.data(), m_scratch.size());
+        }
+
+        m_records += needed;
+        ++m_events;
+        commit();
+    }
+
+    std::uint64_t events() const noexcept { return m_events; }
+
+private:
+    void commit() noexcept
+    {
+        auto const header = m_file.data();
+        std::memcpy(header + offsetof(JournalFileHeader, records), &m_records, sizeof(m_records));
+        std::memcpy(header + offsetof(JournalFileHeader, events), &m_events, sizeof(m_events));
+    }
+
+    EventCodecRegistry const& m_codecs;
+    MappedFile m_file;
+    std::uint64_t m_records = 0;
+    std::uint64_t m_events = 0;
+    std::vector<std::uint8_t> m_scratch;
+};
+
+class EventJournalReader
+{
+public:
+    struct Entry
+    {
+        std::uint64_t sequence;
+        std::uint32_t messageId;
+        std::uint8_t channel;
+        std::uint8_t const* payload; // points into the mapped file
+        std::size_t payloadSize;
+    };
+
+    explicit EventJournalReader(std::string const& p_path)
+        : m_file(MappedFile::openReadOnly(p_path))
+    {
+        if (m_file.size() < sizeof(JournalFileHeader)) {
+            throw std::runtime_error("Truncated event journal: " + p_path);
+        }
+
+        JournalFileHeader header;
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        if (std::memcmp(header.magic, JournalFileHeader::MAGIC, sizeof(header.magic)) != 0 or
+            header.version != JournalFileHeader::VERSION or
+            header.recordSize != sizeof(JournalRecord) or
+            header.records * sizeof(JournalRecord) > m_file.size()) {
+            throw std::runtime_error("Not a valid event journal: " + p_path);
+        }
+
+        m_records = header.records;
+        m_events = header.events;
+    }
+
+    std::uint64_t events() const noexcept { return m_events; }
+
+    // Position of the first event; pass it to read() to walk the journal.
+    std::uint64_t begin() const noexcept { return 1; }
+
+    // Reads the event at p_position and advances it, or returns false at the end of the journal.
+    bool read(std::uint64_t& p_position, Entry& p_entry) const
+    {
+        if (p_position >= m_records) {
+            return false;
+        }
+
+        auto const record = m_file.data() + p_position * sizeof(JournalRecord);
+        JournalRecord header;
+        std::memcpy(&header, record, offsetof(JournalRecord, payload));
+
+        auto const used = JournalRecord::recordsFor(header.payloadSize);
+        if (p_position + used > m_records) {
+            throw std::runtime_error("Event journal ends inside an event");
+        }
+
+        p_entry.sequence = header.sequence;
+        p_entry.messageId = header.messageId;
+        p_entry.channel = header.channel;
+        p_entry.payload = record + offsetof(JournalRecord, payload);
+        p_entry.payloadSize = header.payloadSize;
+
+        p_position += used;
+        return true;
+    }
+
+private:
+    MappedFile m_file;
+    std::uint64_t m_records = 0;
+    std::uint64_t m_events = 0;
+};
+
+// Journals every event on its way into the wrapped handler.
+class JournalingEventHandler : public IEventHandler
+{
+public:
+    JournalingEventHandler(EventJournal& p_journal, IEventHandler& p_handler)
+        : m_journal(p_journal),
+          m_handler(p_handler)
+    {}
+
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        m_journal.append(JOURNAL_INPUT_CHANNEL, *p_event);
+        m_handler.receive(std::move(p_event));
+    }
+
+    // Journals the whole batch, then hands it to the wrapped handler's receiveBatch. As the journal
+    // already has every event, a failing one does not stop the batch here: the rest are handled
+    // too, and the first failure is rethrown once all of them are.
+    void receiveBatch(std::unique_ptr<Event>* p_events, std::size_t p_count) override
+    {
+        for (std::size_t i = 0; i < p_count; ++i) {
+            m_journal.append(JOURNAL_INPUT_CHANNEL, *p_events[i]);
+        }
+
+        std::exception_ptr failure;
+        std::size_t next = 0;
+        while (next < p_count) {
+            try {
+                m_handler.receiveBatch(p_events + next, p_count - next);
+                next = p_count;
+            } catch (...) {
+                if (not failure) {
+                    failure = std::current_exception();
+                }
+                while (next < p_count and not p_events[next]) {
+                    ++next;
+                }
+            }
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+private:
+    EventJournal& m_journal;
+    IEventHandler& m_handler;
+};
+
+// Journals every event on its way out through the wrapped port.
+class JournalingPort : public IPort
+{
+public:
+    JournalingPort(EventJournal& p_journal, std::uint8_t p_channel, IPort& p_port)
+        : m_journal(p_journal),
+          m_channel(p_channel),
+          m_port(p_port)
+    {
+        if (p_channel == JOURNAL_INPUT_CHANNEL) {
+            throw std::invalid_argument("Journal channel 0 is reserved for input events");
+        }
+    }
+
+    void send(std::unique_ptr<Event> p_event) override
+    {
+        m_journal.append(m_channel, *p_event);
+        m_port.send(std::move(p_event));
+    }
+
+private:
+    EventJournal& m_journal;
+    std::uint8_t const m_channel;
+    IPort& m_port;
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+// Per-thread free lists of event-sized blocks. Blocks come from the global operator new and are
+// cached on release instead of being freed, so a thread that keeps creating and destroying events
+// stops hitting malloc once its lists are warm. Each block remembers the thread that allocated it:
+// released on another thread, it goes back to that one through a lock-free return list, which the
+// owner takes over whenever its own list runs dry. Events passed from a producer to a consumer
+// thread thus stop hitting malloc too. A thread that exits leaves behind its few bytes of return
+// lists, as blocks it handed out may still come back; those are then freed by whoever releases them.
+class EventPool
+{
+public:
+    static constexpr std::size_t GRANULARITY = 16;
+    static constexpr std::size_t SIZE_CLASSES = 16;
+    static constexpr std::size_t MAX_POOLED_SIZE = GRANULARITY * SIZE_CLASSES;
+    static constexpr std::size_t MAX_CACHED_BLOCKS = 4096;
+
+    static void* allocate(std::size_t p_size)
+    {
+        if (p_size > MAX_POOLED_SIZE) {
+            return ::operator new(p_size);
+        }
+
+        // Whole blocks even without a pool: the block may be released to a live one later, which
+        // hands it out again as blockSize(p_size) bytes.
+        EventPool* pool = local();
+        if (pool == nullptr) {
+            return newBlock(nullptr, p_size);
+        }
+
+        auto const sizeClass = EventPool::sizeClass(p_size);
+        auto& freeList = pool->m_freeLists[sizeClass];
+        if (freeList.head == nullptr) {
+            pool->takeReturned(sizeClass);
+        }
+        if (freeList.head == nullptr) {
+            return newBlock(pool->m_returns, p_size);
+        }
+
+        Block* block = freeList.head;
+        freeList.head = block->next;
+        --freeList.count;
+        return block + 1;
+    }
+
+    static void deallocate(void* p_block, std::size_t p_size) noexcept
+    {
+        if (p_size > MAX_POOLED_SIZE) {
+            ::operator delete(p_block);
+            return;
+        }
+
+        Block* block = static_cast<Block*>(p_block) - 1;
+        EventPool* pool = local();
+        if (pool and (block->owner == pool->m_returns or block->owner == nullptr)) {
+            pool->cache(block, sizeClass(p_size));
+        } else if (block->owner) {
+            block->owner->giveBack(block, sizeClass(p_size));
+        } else {
+            ::operator delete(block);
+        }
+    }
+
+    EventPool(EventPool const&) = delete;
+    EventPool& operator=(EventPool const&) = delete;
+
+    ~EventPool()
+    {
+        for (auto& freeList : m_freeLists) {
+            freeBlocks(freeList.head);
+        }
+        m_returns->orphan();
+        s_destroyed = true;
+    }
+
+private:
+    struct Returns;
+
+    // Precedes every pooled block; keeps it 16-byte aligned.
+    struct alignas(16) Block
+    {
+        Returns* owner; // return list of the thread that allocated the block, nullptr if none
+        Block* next;    // while in a free list
+    };
+
+    struct FreeList
+    {
+        Block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    // Blocks released on other threads, per size class, until the owner takes them back. Once the
+    // owner is gone its lists hold orphaned() and blocks released to them are freed.
+    struct Returns
+    {
+        std::array<std::atomic<Block*>, SIZE_CLASSES> heads{};
+
+        void giveBack(Block* p_block, std::size_t p_sizeClass) noexcept
+        {
+            auto& head = heads[p_sizeClass];
+            Block* next = head.load(std::memory_order_relaxed);
+            do {
+                if (next == orphaned()) {
+                    ::operator delete(p_block);
+                    return;
+                }
+                p_block->next = next;
+            } while (not head.compare_exchange_weak(next, p_block, std::memory_order_release,
+                                                    std::memory_order_relaxed));
+        }
+
+        void orphan() noexcept
+        {
+            for (auto& head : heads) {
+                freeBlocks(head.exchange(orphaned(), std::memory_order_acquire));
+            }
+        }
+    };
+
+    EventPool()
+        : m_returns(new Returns)
+    {}
+
+    static std::size_t sizeClass(std::size_t p_size) noexcept { return p_size ? (p_size - 1) / GRANULARITY : 0; }
+    static std::size_t blockSize(std::size_t p_size) noexcept { return (sizeClass(p_size) + 1) * GRANULARITY; }
+
+    static void* newBlock(Returns* p_owner, std::size_t p_size)
+    {
+        Block* block = new (::operator new(sizeof(Block) + blockSize(p_size))) Block{p_owner, nullptr};
+        return block + 1;
+    }
+
+    static Block* orphaned() noexcept
+    {
+        static Block sentinel{nullptr, nullptr};
+        return &sentinel;
+    }
+
+    static void freeBlocks(Block* p_head) noexcept
+    {
+        while (p_head) {
+            Block* block = p_head;
+            p_head = block->next;
+            ::operator delete(block);
+        }
+    }
+
+    // Events destroyed during thread teardown, after the pool itself, fall back to the global heap.
+    static EventPool* local() noexcept
+    {
+        if (s_destroyed) {
+            return nullptr;
+        }
+        thread_local EventPool pool;
+        return &pool;
+    }
+
+    void cache(Block* p_block, std::size_t p_sizeClass) noexcept
+    {
+        auto& freeList = m_freeLists[p_sizeClass];
+        if (freeList.count >= MAX_CACHED_BLOCKS) {
+            ::operator delete(p_block);
+            return;
+        }
+
+        p_block->owner = m_returns;
+        p_block->next = freeList.head;
+        freeList.head = p_block;
+        ++freeList.count;
+    }
+
+    // Moves the blocks other threads released back into the (empty) free list of p_sizeClass.
+    void takeReturned(std::size_t p_sizeClass) noexcept
+    {
+        auto& freeList = m_freeLists[p_sizeClass];
+        freeList.head = m_returns->heads[p_sizeClass].exchange(nullptr, std::memory_order_acquire);
+        for (Block* block = freeList.head; block; block = block->next) {
+            ++freeList.count;
+        }
+    }
+
+    static inline thread_local bool s_destroyed = false;
+
+    Returns* m_returns; // never deleted, see orphan()
+    std::array<FreeList, SIZE_CLASSES> m_freeLists;
+};
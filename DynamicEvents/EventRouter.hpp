@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Event.hpp"
+#include "IPort.hpp"
+#include "PerThread.hpp"
+
+// Publish/subscribe port: delivers each event to every port subscribed to its MESSAGE_ID and to
+// every port subscribed to all messages. Routes live in an immutable table indexed by MESSAGE_ID
+// that send() reads without locking; subscribing builds a new table, swaps it in and frees the
+// old one once no send() can still be reading it (read-copy-update with per-thread reader counts).
+// With several receivers the payload is shared between them via Event::share(), not copied.
+//
+// Subscribing and unsubscribing may happen on any thread, but not from inside a delivery: they
+// wait for running sends to finish. Once unsubscribe() returns, the port receives nothing more.
+class EventRouter : public IPort
+{
+public:
+    explicit EventRouter(std::uint32_t p_messageIdLimit = 256)
+        : m_routes(new Routes{std::vector<Ports>(p_messageIdLimit), {}})
+    {}
+
+    ~EventRouter() override { delete m_routes.load(); }
+
+    EventRouter(EventRouter const&) = delete;
+    EventRouter& operator=(EventRouter const&) = delete;
+
+    void subscribe(std::uint32_t p_messageId, IPort& p_port)
+    {
+        update([&](Routes& p_routes) {
+            if (p_messageId >= p_routes.byMessageId.size()) {
+                throw std::out_of_range("MESSAGE_ID beyond the router's table");
+            }
+            p_routes.byMessageId[p_messageId].push_back(&p_port);
+        });
+    }
+
+    void subscribeAll(IPort& p_port)
+    {
+        update([&](Routes& p_routes) {
+            for (auto& ports : p_routes.byMessageId) {
+                ports.push_back(&p_port);
+            }
+            p_routes.others.push_back(&p_port);
+        });
+    }
+
+    // Removes every subscription of p_port.
+    void unsubscribe(IPort& p_port)
+    {
+        update([&](Routes& p_routes) {
+            for (auto& ports : p_routes.byMessageId) {
+                ports.erase(std::remove(ports.begin(), ports.end(), &p_port), ports.end());
+            }
+            p_routes.others.erase(std::remove(p_routes.others.begin(), p_routes.others.end(), &p_port),
+                                  p_routes.others.end());
+        });
+    }
+
+    // Events nobody subscribed to are dropped.
+    void send(std::unique_ptr<Event> p_event) override
+    {
+        auto& active = m_readers.local().active[m_epoch.load() & 1];
+        active.fetch_add(1);
+        ReadGuard const guard{active};
+
+        Routes const& routes = *m_routes.load();
+        auto const messageId = p_event->getMessageId();
+        Ports const& ports = messageId < routes.byMessageId.size() ? routes.byMessageId[messageId] : routes.others;
+
+        if (ports.size() == 1) {
+            ports.front()->send(std::move(p_event));
+        } else if (not ports.empty()) {
+            auto shared = p_event->share();
+            for (std::size_t i = 0; i + 1 < ports.size(); ++i) {
+                ports[i]->send(shared->clone());
+            }
+            ports.back()->send(std::move(shared));
+        }
+    }
+
+private:
+    using Ports = std::vector<IPort*>;
+
+    struct Routes
+    {
+        std::vector<Ports> byMessageId;
+        Ports others; // subscribed to all messages; used for MESSAGE_ID beyond the table
+    };
+
+    struct Readers
+    {
+        std::atomic<std::uint64_t> active[2] = {};
+    };
+
+    // Ends the read even when a subscriber throws, or update() would wait for it forever.
+    struct ReadGuard
+    {
+        std::atomic<std::uint64_t>& active;
+
+        ~ReadGuard() { active.fetch_sub(1, std::memory_order_release); }
+    };
+
+    template <class Change>
+    void update(Change&& p_change)
+    {
+        std::lock_guard<std::mutex> lock(m_writeMutex);
+
+        auto routes = std::make_unique<Routes>(*m_routes.load());
+        p_change(*routes);
+        std::unique_ptr<Routes const> old(m_routes.exchange(routes.release()));
+
+        // A send may have read the epoch just before a flip, so wait out both halves.
+        for (int flip = 0; flip < 2; ++flip) {
+            auto const epoch = m_epoch.fetch_add(1) & 1;
+            while (activeReaders(epoch) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    std::uint64_t activeReaders(std::uint64_t p_epoch) const
+    {
+        std::uint64_t active = 0;
+        m_readers.forEach([&](Readers const& p_readers) { active += p_readers.active[p_epoch].load(); });
+        return active;
+    }
+
+    std::atomic<Routes const*> m_routes;
+    std::atomic<std::uint64_t> m_epoch{0};
+    PerThread<Readers> m_readers;
+    std::mutex m_writeMutex;
+};
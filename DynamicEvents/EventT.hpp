@@ -5,16 +5,33 @@
 #include "Event.hpp"
 
 template <class T>
-class EventT : public Event
+class SharedEventT;
+
+// The part of an event that payload<T>() relies on: EventT owns its T, SharedEventT shares an
+// immutable one between clones and copies it on the first mutable access.
+template <class T>
+class PayloadEvent : public Event
+{
+public:
+    std::uint32_t getMessageId() const override { return T::MESSAGE_ID; }
+
+    virtual T const& get() const noexcept = 0;
+    virtual T& getMutable() = 0;
+
+    std::unique_ptr<Event> share() override { return std::make_unique<SharedEventT<T>>(std::move(getMutable())); }
+};
+
+template <class T>
+class EventT : public PayloadEvent<T>
 {
     static_assert(std::is_copy_constructible<T>::value, "Payload type must be copy-construcible!");
 public:
     EventT(T const& payload = T())
-        : m_payload(std::make_unique<T>(payload))
+        : m_payload(payload)
     {}
 
     EventT(T&& payload)
-        : m_payload(std::make_unique<T>(std::forward<T>(payload)))
+        : m_payload(std::forward<T>(payload))
     {}
 
     EventT(EventT&&) = default;
@@ -22,27 +39,46 @@ public:
     EventT(EventT<T> const&) = delete;
     EventT& operator=(EventT<T> const&) = delete;
 
-    std::uint32_t getMessageId() const override { return T::MESSAGE_ID; };
-    std::unique_ptr<Event> clone() const override { return std::make_unique<EventT<T>>(*m_payload); }
+    std::unique_ptr<Event> clone() const override { return std::make_unique<EventT<T>>(m_payload); }
+
+    T const& get() const noexcept override { return m_payload; }
+    T& getMutable() noexcept override { return m_payload; }
 
-    T * const operator->() noexcept { return m_payload.get(); }
-    T const * const operator->() const noexcept { return m_payload.get(); }
+    T * const operator->() noexcept { return &m_payload; }
+    T const * const operator->() const noexcept { return &m_payload; }
 
-    T& operator*() noexcept { return *m_payload; }
-    T const& operator*() const noexcept { return *m_payload; }
+    T& operator*() noexcept { return m_payload; }
+    T const& operator*() const noexcept { return m_payload; }
 
 private:
-    std::unique_ptr<T> m_payload;
+    T m_payload;
 };
 
+// Checked downcast that needs no RTTI: the event as carrying a T when its MESSAGE_ID says so,
+// nullptr otherwise.
+template <class T>
+PayloadEvent<T>* event_cast(Event& p_evt) noexcept
+{
+    return p_evt.getMessageId() == T::MESSAGE_ID ? static_cast<PayloadEvent<T>*>(&p_evt) : nullptr;
+}
+
+template <class T>
+PayloadEvent<T> const* event_cast(Event const& p_evt) noexcept
+{
+    return p_evt.getMessageId() == T::MESSAGE_ID ? static_cast<PayloadEvent<T> const*>(&p_evt) : nullptr;
+}
+
+// Unchecked: p_evt must carry a T.
 template <class T>
 T const& payload(Event const& p_evt)
 {
-    return *static_cast<EventT<T> const&>(p_evt);
+    return static_cast<PayloadEvent<T> const&>(p_evt).get();
 }
 
 template <class T>
 T& payload(Event& p_evt)
 {
-    return *static_cast<EventT<T>&>(p_evt);
+    return static_cast<PayloadEvent<T>&>(p_evt).getMutable();
 }
+
+#include "SharedEventT.hpp"
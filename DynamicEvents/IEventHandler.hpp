@@ -1,12 +1,22 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
-class Event;
+#include "Event.hpp"
 
 class IEventHandler
 {
 public:
     virtual ~IEventHandler() = default;
     virtual void receive(std::unique_ptr<Event>) = 0;
+
+    // Takes p_count events at once, in order. Each event is left null once handled; when one
+    // throws, it is null too and the caller can go on from the next non-null event.
+    virtual void receiveBatch(std::unique_ptr<Event>* p_events, std::size_t p_count)
+    {
+        for (std::size_t i = 0; i < p_count; ++i) {
+            receive(std::move(p_events[i]));
+        }
+    }
 };
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <vector>
+
+#include "EventCodecRegistry.hpp"
+#include "EventJournal.hpp"
+#include "IEventHandler.hpp"
+#include "IPort.hpp"
+
+// Streams the input events of a journal into a fresh handler and checks everything it sends
+// against the recorded output. Build the handler on top of port(channel) for each journaled port,
+// then call run(). Outputs are compared byte for byte, in recorded order, channel included.
+class JournalReplay
+{
+public:
+    static constexpr std::uint64_t NO_MISMATCH = UINT64_MAX;
+
+    struct Result
+    {
+        std::uint64_t inputs = 0;
+        std::uint64_t outputs = 0;
+        std::uint64_t mismatches = 0;
+        std::uint64_t firstMismatch = NO_MISMATCH; // sequence number of the first recorded event that differs
+    };
+
+    JournalReplay(EventJournalReader const& p_journal, EventCodecRegistry const& p_codecs)
+        : m_journal(p_journal),
+          m_codecs(p_codecs)
+    {}
+
+    JournalReplay(JournalReplay const&) = delete;
+    JournalReplay& operator=(JournalReplay const&) = delete;
+
+    IPort& port(std::uint8_t p_channel)
+    {
+        auto& port = m_ports[p_channel];
+        if (not port) {
+            port = std::make_unique<ComparingPort>(*this, p_channel);
+        }
+        return *port;
+    }
+
+    Result run(IEventHandler& p_handler)
+    {
+        m_result = Result();
+        m_position = m_journal.begin();
+
+        EventJournalReader::Entry entry;
+        while (m_journal.read(m_position, entry)) {
+            if (entry.channel != JOURNAL_INPUT_CHANNEL) {
+                mismatch(entry.sequence);
+                continue;
+            }
+
+            ++m_result.inputs;
+            try {
+                p_handler.receive(m_codecs.decode(entry.messageId, entry.payload, entry.payloadSize));
+            } catch (std::exception const&) {
+                // The recorded run saw the same input and ended the same way.
+            }
+        }
+        return m_result;
+    }
+
+private:
+    class ComparingPort : public IPort
+    {
+    public:
+        ComparingPort(JournalReplay& p_replay, std::uint8_t p_channel)
+            : m_replay(p_replay),
+              m_channel(p_channel)
+        {}
+
+        void send(std::unique_ptr<Event> p_event) override { m_replay.compare(m_channel, *p_event); }
+
+    private:
+        JournalReplay& m_replay;
+        std::uint8_t const m_channel;
+    };
+
+    void compare(std::uint8_t p_channel, Event const& p_event)
+    {
+        ++m_result.outputs;
+
+        auto position = m_position;
+        EventJournalReader::Entry expected;
+        if (not m_journal.read(position, expected)) {
+            mismatch(m_journal.events());
+            return;
+        }
+        if (expected.channel == JOURNAL_INPUT_CHANNEL) {
+            mismatch(expected.sequence);
+            return;
+        }
+        m_position = position;
+
+        m_codecs.encode(p_event, m_scratch);
+        if (expected.channel != p_channel or
+            expected.messageId != p_event.getMessageId() or
+            expected.payloadSize != m_scratch.size() or
+            (expected.payloadSize and std::memcmp(expected.payload, m_scratch.data(), m_scratch.size()) != 0)) {
+            mismatch(expected.sequence);
+        }
+    }
+
+    void mismatch(std::uint64_t p_sequence) noexcept
+    {
+        if (m_result.mismatches++ == 0) {
+            m_result.firstMismatch = p_sequence;
+        }
+    }
+
+    EventJournalReader const& m_journal;
+    EventCodecRegistry const& m_codecs;
+    std::array<std::unique_ptr<ComparingPort>, 256> m_ports;
+
+    std::uint64_t m_position = 0;
+    Result m_result;
+    std::vector<std::uint8_t> m_scratch;
+};
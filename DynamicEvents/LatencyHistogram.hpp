@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Log-linear histogram in the style of HdrHistogram: values are grouped by power of two and each
+// power is split into 16 linear sub-buckets, which keeps the relative error under 1/16 from 1 to
+// 2^64 in under 8 kB. Updated by a single writer thread; any thread may read it at any time.
+class LatencyHistogram
+{
+public:
+    static constexpr std::size_t SUB_BUCKET_BITS = 4;
+    static constexpr std::size_t SUB_BUCKETS = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    void record(std::uint64_t p_value) noexcept
+    {
+        bump(m_buckets[bucketOf(p_value)], 1);
+        bump(m_count, 1);
+        bump(m_sum, p_value);
+        if (p_value > m_max.load(std::memory_order_relaxed)) {
+            m_max.store(p_value, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+    std::uint64_t sum() const noexcept { return m_sum.load(std::memory_order_relaxed); }
+    std::uint64_t max() const noexcept { return m_max.load(std::memory_order_relaxed); }
+
+    // Adds another histogram's samples to this one; used to fold per-thread histograms together.
+    void merge(LatencyHistogram const& p_other) noexcept
+    {
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            bump(m_buckets[i], p_other.m_buckets[i].load(std::memory_order_relaxed));
+        }
+        bump(m_count, p_other.count());
+        bump(m_sum, p_other.sum());
+        if (p_other.max() > max()) {
+            m_max.store(p_other.max(), std::memory_order_relaxed);
+        }
+    }
+
+    // Lower bound of the bucket holding the given percentile (0-100), or 0 when empty.
+    std::uint64_t percentile(double p_percentile) const noexcept
+    {
+        auto const total = count();
+        if (total == 0) {
+            return 0;
+        }
+
+        auto const rank = static_cast<std::uint64_t>(p_percentile / 100.0 * static_cast<double>(total - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            seen += m_buckets[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return lowerBound(i);
+            }
+        }
+        return max();
+    }
+
+    static std::size_t bucketOf(std::uint64_t p_value) noexcept
+    {
+        if (p_value < SUB_BUCKETS) {
+            return static_cast<std::size_t>(p_value);
+        }
+        auto const magnitude = 63 - static_cast<std::size_t>(__builtin_clzll(p_value));
+        auto const shift = magnitude - SUB_BUCKET_BITS;
+        auto const subBucket = static_cast<std::size_t>(p_value >> shift) & (SUB_BUCKETS - 1);
+        return (shift + 1) * SUB_BUCKETS + subBucket;
+    }
+
+    static std::uint64_t lowerBound(std::size_t p_bucket) noexcept
+    {
+        if (p_bucket < SUB_BUCKETS) {
+            return p_bucket;
+        }
+        auto const shift = p_bucket / SUB_BUCKETS - 1;
+        auto const subBucket = p_bucket % SUB_BUCKETS;
+        return (SUB_BUCKETS + subBucket) << shift;
+    }
+
+private:
+    // Single writer: a plain load and store, no locked read-modify-write.
+    static void bump(std::atomic<std::uint64_t>& p_counter, std::uint64_t p_by) noexcept
+    {
+        p_counter.store(p_counter.load(std::memory_order_relaxed) + p_by, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint64_t>, BUCKETS> m_buckets{};
+    std::atomic<std::uint64_t> m_count{0};
+    std::atomic<std::uint64_t> m_sum{0};
+    std::atomic<std::uint64_t> m_max{0};
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Owns a shared POSIX memory mapping of a whole file, or of a named shared memory object.
+class MappedFile
+{
+public:
+    static MappedFile openReadOnly(std::string const& p_path)
+    {
+        int const fd = ::open(p_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throwSystemError("open " + p_path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throwSystemError("fstat " + p_path);
+        }
+
+        return MappedFile(fd, static_cast<std::size_t>(info.st_size), PROT_READ);
+    }
+
+    // Creates or truncates the file to p_size bytes and maps it for writing.
+    static MappedFile create(std::string const& p_path, std::size_t p_size)
+    {
+        int const fd = ::open(p_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throwSystemError("open " + p_path);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(p_size)) != 0) {
+            ::close(fd);
+            throwSystemError("ftruncate " + p_path);
+        }
+
+        return MappedFile(fd, p_size, PROT_READ | PROT_WRITE);
+    }
+
+    // Creates the shared memory object p_name ("/name") of p_size bytes, failing if it exists.
+    static MappedFile createShared(std::string const& p_name, std::size_t p_size)
+    {
+        int const fd = ::shm_open(p_name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            throwSystemError("shm_open " + p_name);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(p_size)) != 0) {
+            int const error = errno;
+            ::close(fd);
+            ::shm_unlink(p_name.c_str());
+            throw std::system_error(error, std::generic_category(), "ftruncate " + p_name);
+        }
+
+        return MappedFile(fd, p_size, PROT_READ | PROT_WRITE);
+    }
+
+    // Maps an existing shared memory object for reading and writing.
+    static MappedFile openShared(std::string const& p_name)
+    {
+        int const fd = ::shm_open(p_name.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (fd < 0) {
+            throwSystemError("shm_open " + p_name);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throwSystemError("fstat " + p_name);
+        }
+
+        return MappedFile(fd, static_cast<std::size_t>(info.st_size), PROT_READ | PROT_WRITE);
+    }
+
+    // Removes the name; processes that mapped the object keep their mapping.
+    static void unlinkShared(std::string const& p_name) noexcept { ::shm_unlink(p_name.c_str()); }
+
+    MappedFile(MappedFile&& p_rhs) noexcept
+        : m_fd(std::exchange(p_rhs.m_fd, -1)),
+          m_data(std::exchange(p_rhs.m_data, nullptr)),
+          m_size(std::exchange(p_rhs.m_size, 0)),
+          m_protection(p_rhs.m_protection)
+    {}
+
+    MappedFile& operator=(MappedFile&& p_rhs) noexcept
+    {
+        if (this != &p_rhs) {
+            release();
+            m_fd = std::exchange(p_rhs.m_fd, -1);
+            m_data = std::exchange(p_rhs.m_data, nullptr);
+            m_size = std::exchange(p_rhs.m_size, 0);
+            m_protection = p_rhs.m_protection;
+        }
+        return *this;
+    }
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    ~MappedFile() { release(); }
+
+    // Grows or shrinks the file and maps it again; earlier data() pointers become invalid.
+    void resize(std::size_t p_size)
+    {
+        if (m_data) {
+            ::munmap(m_data, m_size);
+            m_data = nullptr;
+        }
+        if (::ftruncate(m_fd, static_cast<off_t>(p_size)) != 0) {
+            throwSystemError("ftruncate");
+        }
+        m_size = p_size;
+        map();
+    }
+
+    std::uint8_t* data() noexcept { return static_cast<std::uint8_t*>(m_data); }
+    std::uint8_t const* data() const noexcept { return static_cast<std::uint8_t const*>(m_data); }
+    std::size_t size() const noexcept { return m_size; }
+
+private:
+    MappedFile(int p_fd, std::size_t p_size, int p_protection)
+        : m_fd(p_fd),
+          m_size(p_size),
+          m_protection(p_protection)
+    {
+        map();
+    }
+
+    void map()
+    {
+        if (m_size == 0) {
+            return;
+        }
+        void* data = ::mmap(nullptr, m_size, m_protection, MAP_SHARED, m_fd, 0);
+        if (data == MAP_FAILED) {
+            int const error = errno;
+            release();
+            throw std::system_error(error, std::generic_category(), "mmap");
+        }
+        m_data = data;
+    }
+
+    void release() noexcept
+    {
+        if (m_data) {
+            ::munmap(m_data, m_size);
+            m_data = nullptr;
+        }
+        if (m_fd >= 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    [[noreturn]] static void throwSystemError(std::string const& p_what)
+    {
+        throw std::system_error(errno, std::generic_category(), p_what);
+    }
+
+    int m_fd = -1;
+    void* m_data = nullptr;
+    std::size_t m_size = 0;
+    int m_protection = PROT_READ;
+};
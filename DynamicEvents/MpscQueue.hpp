@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Bounded lock-free queue after Dmitry Vyukov's sequence-numbered ring. Any number of threads may
+// push. Popping is also safe from several threads, which lets producers evict the oldest entry
+// when the queue is full, but the queue is meant to be drained by a single consumer.
+template <class T>
+class MpscQueue
+{
+public:
+    explicit MpscQueue(std::size_t p_capacity)
+        : m_capacity(roundUpToPowerOfTwo(p_capacity)),
+          m_cells(std::make_unique<Cell[]>(m_capacity))
+    {
+        for (std::size_t i = 0; i < m_capacity; ++i) {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(MpscQueue const&) = delete;
+    MpscQueue& operator=(MpscQueue const&) = delete;
+
+    // Moves from p_value only when there was room.
+    bool tryPush(T& p_value)
+    {
+        std::size_t position = m_enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = m_cells[position & (m_capacity - 1)];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+            auto const lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (lag == 0) {
+                if (m_enqueuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(p_value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& p_value)
+    {
+        std::size_t position = m_dequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = m_cells[position & (m_capacity - 1)];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+            auto const lag = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (lag == 0) {
+                if (m_dequeuePos.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    p_value = std::move(cell.value);
+                    cell.sequence.store(position + m_capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Approximate while producers or consumers are active.
+    std::size_t size() const noexcept
+    {
+        auto const dequeued = m_dequeuePos.load(std::memory_order_acquire);
+        auto const enqueued = m_enqueuePos.load(std::memory_order_acquire);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t p_value) noexcept
+    {
+        std::size_t result = 2;
+        while (result < p_value) {
+            result *= 2;
+        }
+        return result;
+    }
+
+    std::size_t const m_capacity;
+    std::unique_ptr<Cell[]> m_cells;
+
+    alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+    alignas(64) std::atomic<std::size_t> m_dequeuePos{0};
+};
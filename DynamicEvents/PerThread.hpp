@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One T per thread that touches this object, each in its own cache lines. Each thread keeps a
+// cache of its slots indexed by a small per-object index, reused once the object is gone, so
+// local() takes a lock only the first time a thread uses an object, however many objects it
+// alternates between. forEach() visits every thread's T and is meant for occasional readers such
+// as a stats dump. T must tolerate concurrent reads (e.g. atomics).
+template <class T>
+class PerThread
+{
+public:
+    PerThread()
+        : m_index(acquireIndex())
+    {}
+
+    ~PerThread() { releaseIndex(m_index); }
+
+    PerThread(PerThread const&) = delete;
+    PerThread& operator=(PerThread const&) = delete;
+
+    T& local()
+    {
+        thread_local std::vector<Cache> caches;
+        if (m_index >= caches.size()) {
+            caches.resize(m_index + 1);
+        }
+        auto& cache = caches[m_index];
+        if (cache.instance != m_instance) {
+            cache.instance = m_instance;
+            cache.slot = &registerThread();
+        }
+        return *cache.slot;
+    }
+
+    template <class F>
+    void forEach(F&& p_visit) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto const& slot : m_slots) {
+            p_visit(static_cast<T const&>(slot->value));
+        }
+    }
+
+private:
+    struct alignas(64) Slot
+    {
+        std::thread::id owner;
+        T value;
+    };
+
+    struct Cache
+    {
+        std::uint64_t instance = 0;
+        T* slot = nullptr;
+    };
+
+    T& registerThread()
+    {
+        auto const self = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& slot : m_slots) {
+            if (slot->owner == self) {
+                return slot->value;
+            }
+        }
+        m_slots.push_back(std::make_unique<Slot>());
+        m_slots.back()->owner = self;
+        return m_slots.back()->value;
+    }
+
+    // Unique per object, so a new PerThread at a reused index never hits a stale cache.
+    static std::uint64_t nextInstance() noexcept
+    {
+        static std::atomic<std::uint64_t> instances{0};
+        return ++instances;
+    }
+
+    struct Indices
+    {
+        std::mutex mutex;
+        std::vector<std::size_t> free;
+        std::size_t used = 0;
+    };
+
+    // Never destroyed, so that PerThread objects with static storage can still release theirs.
+    static Indices& indices()
+    {
+        static Indices* indices = new Indices;
+        return *indices;
+    }
+
+    static std::size_t acquireIndex()
+    {
+        auto& all = indices();
+        std::lock_guard<std::mutex> lock(all.mutex);
+        if (all.free.empty()) {
+            // Room for every index to come back, so that releasing one never allocates.
+            all.free.reserve(all.used + 1);
+            return all.used++;
+        }
+        auto const index = all.free.back();
+        all.free.pop_back();
+        return index;
+    }
+
+    static void releaseIndex(std::size_t p_index) noexcept
+    {
+        auto& all = indices();
+        std::lock_guard<std::mutex> lock(all.mutex);
+        all.free.push_back(p_index);
+    }
+
+    std::size_t const m_index;
+    std::uint64_t const m_instance = nextInstance();
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<Slot>> m_slots;
+};
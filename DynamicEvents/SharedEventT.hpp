@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+#include "EventT.hpp"
+
+// Event whose payload is shared by all of its clones: clone() allocates only the small event
+// object and bumps a reference count, however large T is. Meant for fan-out of payloads such as
+// DisplayBatchInd to many receivers. Readers see one immutable T; the mutable payload<T>(Event&)
+// first gives the event a private copy if anybody else still holds the shared one, so readers
+// should go through an Event const&. Copy-on-write is sound only once the reads of every other
+// holder happen-before that check, as they do when each clone is destroyed after its last read,
+// on the thread that read it; getMutable() then orders its writes after them.
+template <class T>
+class SharedEventT : public PayloadEvent<T>
+{
+    static_assert(std::is_copy_constructible<T>::value, "Payload type must be copy-construcible!");
+public:
+    SharedEventT(T const& payload = T())
+        : m_payload(std::make_shared<T>(payload))
+    {}
+
+    SharedEventT(T&& payload)
+        : m_payload(std::make_shared<T>(std::forward<T>(payload)))
+    {}
+
+    SharedEventT(SharedEventT&&) = default;
+
+    SharedEventT& operator=(SharedEventT<T> const&) = delete;
+
+    std::unique_ptr<Event> clone() const override { return std::unique_ptr<Event>(new SharedEventT<T>(*this)); }
+    // Already shared: a clone, leaving this event as it was.
+    std::unique_ptr<Event> share() override { return clone(); }
+
+    T const& get() const noexcept override { return *m_payload; }
+
+    T& getMutable() override
+    {
+        if (isShared()) {
+            m_payload = std::make_shared<T>(*m_payload);
+        } else {
+            // use_count() is a relaxed load; pairs with the release of the count by the last clone
+            // destroyed, so that the writes to come are ordered after the reads made through it.
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *m_payload;
+    }
+
+    T const* operator->() const noexcept { return m_payload.get(); }
+    T const& operator*() const noexcept { return *m_payload; }
+
+    // True while a clone (or the event this one was cloned from) still holds the same payload.
+    bool isShared() const noexcept { return m_payload.use_count() != 1; }
+
+private:
+    SharedEventT(SharedEventT<T> const&) = default;
+
+    std::shared_ptr<T> m_payload;
+};
@@ -0,0 +1,374 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Event.hpp"
+#include "EventCodecRegistry.hpp"
+#include "IEventHandler.hpp"
+#include "IPort.hpp"
+#include "MappedFile.hpp"
+
+// Control block at the start of the shared memory object; the records follow it. Positions are
+// byte counts since creation, so head - tail is the number of bytes in use.
+struct SharedRingHeader
+{
+    static constexpr char MAGIC[4] = {'S', 'H', 'R', 'G'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t capacity;
+
+    alignas(64) std::atomic<std::uint64_t> head;        // written by the producer only
+    alignas(64) std::atomic<std::uint64_t> tail;        // written by the consumer only
+    alignas(64) std::atomic<std::uint32_t> consumerWaiting; // futex word, 1 while the consumer sleeps
+};
+
+// Each record is this header and the payload, padded to RECORD_ALIGNMENT. A record never wraps
+// around the end of the ring; the space left there is filled with a PADDING_ID record instead.
+struct SharedRingRecord
+{
+    static constexpr std::uint32_t PADDING_ID = 0xFFFFFFFF;
+    static constexpr std::size_t RECORD_ALIGNMENT = 8;
+
+    std::uint32_t messageId;
+    std::uint32_t payloadSize;
+
+    static std::size_t sizeFor(std::size_t p_payloadSize) noexcept
+    {
+        return (sizeof(SharedRingRecord) + p_payloadSize + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+    }
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free and std::atomic<std::uint32_t>::is_always_lock_free,
+              "The ring is shared between processes, so its atomics must not use locks");
+
+// Single-producer single-consumer ring of events in POSIX shared memory, for talking to another
+// process. The producer writes each payload straight into the ring and the consumer reads it
+// there. The consumer sleeps on a futex when the ring is empty, and the producer only makes the
+// wake-up system call when the consumer is asleep.
+class SharedMemoryRing
+{
+public:
+    // Creates the shared memory object p_name holding a ring of p_capacity bytes, a power of two.
+    // The creator removes the name again when destroyed.
+    static SharedMemoryRing create(std::string const& p_name, std::size_t p_capacity)
+    {
+        if (p_capacity < 2 * sizeof(SharedRingRecord) or (p_capacity & (p_capacity - 1)) != 0) {
+            throw std::invalid_argument("Shared ring capacity must be a power of two of at least 16 bytes");
+        }
+
+        SharedMemoryRing ring(MappedFile::createShared(p_name, sizeof(SharedRingHeader) + p_capacity), p_name);
+        auto header = new (ring.m_file.data()) SharedRingHeader{};
+        std::memcpy(header->magic, SharedRingHeader::MAGIC, sizeof(header->magic));
+        header->version = SharedRingHeader::VERSION;
+        header->capacity = p_capacity;
+        ring.attach();
+        return ring;
+    }
+
+    // Attaches to a ring created by another process.
+    static SharedMemoryRing open(std::string const& p_name)
+    {
+        SharedMemoryRing ring(MappedFile::openShared(p_name), std::string());
+        auto const header = reinterpret_cast<SharedRingHeader const*>(ring.m_file.data());
+        if (ring.m_file.size() < sizeof(SharedRingHeader) or
+            std::memcmp(header->magic, SharedRingHeader::MAGIC, sizeof(header->magic)) != 0 or
+            header->version != SharedRingHeader::VERSION or
+            sizeof(SharedRingHeader) + header->capacity != ring.m_file.size()) {
+            throw std::runtime_error("Not a valid shared ring: " + p_name);
+        }
+        ring.attach();
+        return ring;
+    }
+
+    SharedMemoryRing(SharedMemoryRing&& p_rhs) noexcept
+        : m_file(std::move(p_rhs.m_file)),
+          m_owner(std::exchange(p_rhs.m_owner, std::string())),
+          m_header(p_rhs.m_header),
+          m_records(p_rhs.m_records),
+          m_capacity(p_rhs.m_capacity),
+          m_head(p_rhs.m_head),
+          m_cachedTail(p_rhs.m_cachedTail),
+          m_wakeups(p_rhs.m_wakeups)
+    {}
+
+    SharedMemoryRing& operator=(SharedMemoryRing&&) = delete;
+
+    ~SharedMemoryRing()
+    {
+        if (not m_owner.empty()) {
+            MappedFile::unlinkShared(m_owner);
+        }
+    }
+
+    std::size_t capacity() const noexcept { return m_capacity; }
+
+    // Largest payload a record can carry.
+    std::size_t maxPayloadSize() const noexcept
+    {
+        return m_capacity / 2 - sizeof(SharedRingRecord);
+    }
+
+    // Producer side. Returns where to write a p_size byte payload, or nullptr while the ring is
+    // too full. Reserved records reach the consumer on publish().
+    std::uint8_t* tryReserve(std::uint32_t p_messageId, std::size_t p_size)
+    {
+        if (p_size > maxPayloadSize()) {
+            throw std::length_error("Event payload too large for the shared ring");
+        }
+
+        auto const size = SharedRingRecord::sizeFor(p_size);
+        auto const offset = m_head & (m_capacity - 1);
+        auto const padding = offset + size > m_capacity ? m_capacity - offset : 0;
+        if (not hasRoom(padding + size)) {
+            return nullptr;
+        }
+
+        if (padding) {
+            writeRecordHeader(offset, SharedRingRecord::PADDING_ID, padding - sizeof(SharedRingRecord));
+            m_head += padding;
+        }
+
+        auto const start = m_head & (m_capacity - 1);
+        writeRecordHeader(start, p_messageId, p_size);
+        m_head += size;
+        return m_records + start + sizeof(SharedRingRecord);
+    }
+
+    void publish()
+    {
+        // Store then load, both seq_cst, against the consumer's store then load in waitForData():
+        // either it sees the new head or this sees it waiting.
+        m_header->head.store(m_head, std::memory_order_seq_cst);
+        if (m_header->consumerWaiting.load(std::memory_order_seq_cst)) {
+            m_header->consumerWaiting.store(0, std::memory_order_relaxed);
+            futex(FUTEX_WAKE, 1, nullptr);
+            ++m_wakeups;
+        }
+    }
+
+    // Wake-up system calls made by this producer.
+    std::uint64_t wakeups() const noexcept { return m_wakeups; }
+
+    // Consumer side. Calls p_visit(messageId, payload, size) for up to p_max published records,
+    // with the payload still in the ring, then hands their space back to the producer. When
+    // p_visit throws, the records visited so far, the throwing one included, are consumed.
+    template <class Visit>
+    std::size_t consume(Visit&& p_visit, std::size_t p_max = std::numeric_limits<std::size_t>::max())
+    {
+        auto const head = m_header->head.load(std::memory_order_acquire);
+        auto tail = m_header->tail.load(std::memory_order_relaxed);
+
+        struct TailGuard
+        {
+            std::atomic<std::uint64_t>& shared;
+            std::uint64_t const& tail;
+
+            ~TailGuard() { shared.store(tail, std::memory_order_release); }
+        } const guard{m_header->tail, tail};
+
+        std::size_t visited = 0;
+        while (tail != head and visited < p_max) {
+            auto const offset = tail & (m_capacity - 1);
+            SharedRingRecord record;
+            std::memcpy(&record, m_records + offset, sizeof(record));
+            tail += SharedRingRecord::sizeFor(record.payloadSize);
+            if (record.messageId == SharedRingRecord::PADDING_ID) {
+                continue;
+            }
+
+            p_visit(record.messageId, static_cast<std::uint8_t const*>(m_records + offset + sizeof(record)),
+                    static_cast<std::size_t>(record.payloadSize));
+            ++visited;
+        }
+        return visited;
+    }
+
+    bool empty() const noexcept
+    {
+        return m_header->head.load(std::memory_order_seq_cst) == m_header->tail.load(std::memory_order_relaxed);
+    }
+
+    // Sleeps until there is something to consume or p_timeout has passed; true in the first case.
+    bool waitForData(std::chrono::nanoseconds p_timeout)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + p_timeout;
+        while (empty()) {
+            auto const left = deadline - std::chrono::steady_clock::now();
+            if (left <= left.zero()) {
+                return false;
+            }
+
+            m_header->consumerWaiting.store(1, std::memory_order_seq_cst);
+            if (empty()) {
+                auto const seconds = std::chrono::duration_cast<std::chrono::seconds>(left);
+                timespec timeout{static_cast<std::time_t>(seconds.count()),
+                                 static_cast<long>(std::chrono::nanoseconds(left - seconds).count())};
+                futex(FUTEX_WAIT, 1, &timeout);
+            }
+            m_header->consumerWaiting.store(0, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+private:
+    SharedMemoryRing(MappedFile p_file, std::string p_owner)
+        : m_file(std::move(p_file)),
+          m_owner(std::move(p_owner))
+    {}
+
+    void attach() noexcept
+    {
+        m_header = reinterpret_cast<SharedRingHeader*>(m_file.data());
+        m_records = m_file.data() + sizeof(SharedRingHeader);
+        m_capacity = m_header->capacity;
+        m_head = m_header->head.load(std::memory_order_relaxed);
+        m_cachedTail = m_header->tail.load(std::memory_order_acquire);
+    }
+
+    bool hasRoom(std::size_t p_size) noexcept
+    {
+        if (m_head + p_size - m_cachedTail <= m_capacity) {
+            return true;
+        }
+        m_cachedTail = m_header->tail.load(std::memory_order_acquire);
+        return m_head + p_size - m_cachedTail <= m_capacity;
+    }
+
+    void writeRecordHeader(std::uint64_t p_offset, std::uint32_t p_messageId, std::size_t p_size) noexcept
+    {
+        SharedRingRecord const record{p_messageId, static_cast<std::uint32_t>(p_size)};
+        std::memcpy(m_records + p_offset, &record, sizeof(record));
+    }
+
+    // Not FUTEX_PRIVATE: the word is shared with another process.
+    long futex(int p_operation, std::uint32_t p_value, timespec const* p_timeout) noexcept
+    {
+        return ::syscall(SYS_futex, &m_header->consumerWaiting, p_operation, p_value, p_timeout, nullptr, 0);
+    }
+
+    MappedFile m_file;
+    std::string m_owner; // name to remove on destruction, empty when attached with open()
+    SharedRingHeader* m_header = nullptr;
+    std::uint8_t* m_records = nullptr;
+    std::uint64_t m_capacity = 0;
+
+    std::uint64_t m_head = 0;       // producer's next write position, published by publish()
+    std::uint64_t m_cachedTail = 0; // producer's last view of the tail, refreshed when short of room
+    std::uint64_t m_wakeups = 0;
+};
+
+// IPort writing events into a SharedMemoryRing. Payloads of a fixed size are encoded straight
+// into the ring; the others go through the codec's encoder and one copy.
+class SharedMemoryPort : public IPort
+{
+public:
+    enum class Backpressure
+    {
+        Block,  // wait for the consumer to make room
+        Reject  // discard the event
+    };
+
+    SharedMemoryPort(SharedMemoryRing& p_ring, EventCodecRegistry const& p_codecs,
+                     Backpressure p_backpressure = Backpressure::Block)
+        : m_ring(p_ring),
+          m_codecs(p_codecs),
+          m_backpressure(p_backpressure)
+    {}
+
+    void send(std::unique_ptr<Event> p_event) override
+    {
+        auto const messageId = p_event->getMessageId();
+        auto const fixedSize = m_codecs.fixedSize(messageId);
+        if (fixedSize != EventCodecRegistry::VARIABLE_SIZE) {
+            if (auto const destination = reserve(messageId, fixedSize)) {
+                m_codecs.encodeInPlace(*p_event, destination);
+                m_ring.publish();
+            }
+            return;
+        }
+
+        m_codecs.encode(*p_event, m_scratch);
+        if (auto const destination = reserve(messageId, m_scratch.size())) {
+            if (not m_scratch.empty()) {
+                std::memcpy(destination, m_scratch.data(), m_scratch.size());
+            }
+            m_ring.publish();
+        }
+    }
+
+    std::uint64_t rejected() const noexcept { return m_rejected; }
+
+private:
+    std::uint8_t* reserve(std::uint32_t p_messageId, std::size_t p_size)
+    {
+        auto destination = m_ring.tryReserve(p_messageId, p_size);
+        while (not destination and m_backpressure == Backpressure::Block) {
+            std::this_thread::yield();
+            destination = m_ring.tryReserve(p_messageId, p_size);
+        }
+        if (not destination) {
+            ++m_rejected;
+        }
+        return destination;
+    }
+
+    SharedMemoryRing& m_ring;
+    EventCodecRegistry const& m_codecs;
+    Backpressure const m_backpressure;
+    std::vector<std::uint8_t> m_scratch;
+    std::uint64_t m_rejected = 0;
+};
+
+// Consumer side of a SharedMemoryPort: decodes the events in the ring and passes them on. Readers
+// that can use payloads in place call SharedMemoryRing::consume() directly instead.
+class SharedMemoryReader
+{
+public:
+    SharedMemoryReader(SharedMemoryRing& p_ring, EventCodecRegistry const& p_codecs, IEventHandler& p_handler)
+        : m_ring(p_ring),
+          m_codecs(p_codecs),
+          m_handler(p_handler)
+    {}
+
+    // Delivers up to p_max events already in the ring and returns how many it delivered.
+    std::size_t poll(std::size_t p_max = std::numeric_limits<std::size_t>::max())
+    {
+        return m_ring.consume(
+            [this](std::uint32_t p_messageId, std::uint8_t const* p_payload, std::size_t p_size) {
+                m_handler.receive(m_codecs.decode(p_messageId, p_payload, p_size));
+            },
+            p_max);
+    }
+
+    // poll(), after sleeping up to p_timeout for the ring to become non-empty.
+    std::size_t waitAndPoll(std::chrono::nanoseconds p_timeout)
+    {
+        return m_ring.waitForData(p_timeout) ? poll() : 0;
+    }
+
+private:
+    SharedMemoryRing& m_ring;
+    EventCodecRegistry const& m_codecs;
+    IEventHandler& m_handler;
+};
@@ -0,0 +1,144 @@
+#include "AsyncEventHandler.hpp"
+
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct SequenceMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x01;
+
+    int producer;
+    int sequence;
+};
+
+class RecordingHandler : public IEventHandler
+{
+public:
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        received.push_back(payload<SequenceMsg>(*p_event));
+    }
+
+    std::vector<SequenceMsg> received;
+};
+
+// Holds the consumer in its first receive() until released, so the inbox can be filled up.
+class GatedHandler : public RecordingHandler
+{
+public:
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        if (received.empty()) {
+            entered.set_value();
+            gate.wait();
+        }
+        RecordingHandler::receive(std::move(p_event));
+    }
+
+    std::promise<void> entered;
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+};
+
+std::unique_ptr<Event> message(int p_producer, int p_sequence)
+{
+    return std::make_unique<EventT<SequenceMsg>>(SequenceMsg{p_producer, p_sequence});
+}
+
+} // namespace
+
+TEST(MpscQueueTest, test_PushBeyondCapacity_Fails)
+{
+    MpscQueue<int> queue(2);
+    int value = 1;
+
+    EXPECT_TRUE(queue.tryPush(value));
+    EXPECT_TRUE(queue.tryPush(value));
+    EXPECT_FALSE(queue.tryPush(value));
+    EXPECT_EQ(2u, queue.size());
+
+    EXPECT_TRUE(queue.tryPop(value));
+    EXPECT_TRUE(queue.tryPush(value));
+}
+
+TEST(AsyncEventHandlerTest, test_ManyProducers_AllEventsDeliveredInPerProducerOrder)
+{
+    RecordingHandler handler;
+    {
+        AsyncEventHandler sut(handler, 64);
+
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < 4; ++producer) {
+            producers.emplace_back([&sut, producer] {
+                for (int i = 0; i < 5000; ++i) {
+                    sut.receive(message(producer, i));
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+
+        EXPECT_EQ(20000u, sut.stats().enqueued);
+    }
+
+    ASSERT_EQ(20000u, handler.received.size());
+    std::vector<int> next(4, 0);
+    for (auto const& msg : handler.received) {
+        EXPECT_EQ(next[msg.producer]++, msg.sequence);
+    }
+}
+
+TEST(AsyncEventHandlerTest, test_DropOldest_KeepsNewestEventsWhenFull)
+{
+    GatedHandler handler;
+    {
+        AsyncEventHandler sut(handler, 2, AsyncEventHandler::Backpressure::DropOldest);
+        sut.receive(message(0, 0));
+        handler.entered.get_future().wait();
+
+        for (int i = 1; i <= 5; ++i) {
+            sut.receive(message(0, i));
+        }
+
+        auto const stats = sut.stats();
+        EXPECT_EQ(2u, stats.depth);
+        EXPECT_EQ(3u, stats.dropped);
+        handler.release.set_value();
+    }
+
+    ASSERT_EQ(3u, handler.received.size());
+    EXPECT_EQ(4, handler.received[1].sequence);
+    EXPECT_EQ(5, handler.received[2].sequence);
+}
+
+TEST(AsyncEventHandlerTest, test_Reject_DiscardsIncomingEventsWhenFull)
+{
+    GatedHandler handler;
+    {
+        AsyncEventHandler sut(handler, 2, AsyncEventHandler::Backpressure::Reject);
+        sut.receive(message(0, 0));
+        handler.entered.get_future().wait();
+
+        for (int i = 1; i <= 5; ++i) {
+            sut.receive(message(0, i));
+        }
+
+        EXPECT_EQ(3u, sut.stats().rejected);
+        handler.release.set_value();
+    }
+
+    ASSERT_EQ(3u, handler.received.size());
+    EXPECT_EQ(1, handler.received[1].sequence);
+    EXPECT_EQ(2, handler.received[2].sequence);
+}
@@ -0,0 +1,241 @@
+#include "EventJournal.hpp"
+#include "JournalReplay.hpp"
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct NumberMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x01;
+
+    int value;
+};
+
+struct BlobMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x02;
+
+    char bytes[100];
+};
+
+// Over 64 KiB, as a display batch of a long snake can be.
+struct LargeMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x03;
+
+    char bytes[1 << 17];
+};
+
+// Sends every number it receives, plus an offset, to its port.
+class EchoHandler : public IEventHandler
+{
+public:
+    EchoHandler(IPort& p_port, int p_offset)
+        : m_port(p_port), m_offset(p_offset)
+    {}
+
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        if (p_event->getMessageId() == NumberMsg::MESSAGE_ID) {
+            m_port.send(std::make_unique<EventT<NumberMsg>>(NumberMsg{payload<NumberMsg>(*p_event).value + m_offset}));
+        }
+    }
+
+private:
+    IPort& m_port;
+    int m_offset;
+};
+
+// Keeps the numbers it is given, one batch at a time, and throws on p_failOn.
+class BatchHandler : public IEventHandler
+{
+public:
+    explicit BatchHandler(int p_failOn)
+        : m_failOn(p_failOn)
+    {}
+
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        values.push_back(payload<NumberMsg>(*p_event).value);
+        if (values.back() == m_failOn) {
+            throw std::runtime_error("Failing on purpose");
+        }
+    }
+
+    void receiveBatch(std::unique_ptr<Event>* p_events, std::size_t p_count) override
+    {
+        batches.push_back(p_count);
+        IEventHandler::receiveBatch(p_events, p_count);
+    }
+
+    std::vector<int> values;
+    std::vector<std::size_t> batches;
+
+private:
+    int m_failOn;
+};
+
+class NullPort : public IPort
+{
+public:
+    void send(std::unique_ptr<Event>) override {}
+};
+
+struct EventJournalTest : Test
+{
+    EventJournalTest()
+    {
+        codecs.add<NumberMsg>();
+        codecs.add<BlobMsg>();
+        codecs.add<LargeMsg>();
+    }
+
+    ~EventJournalTest() override { std::remove(path.c_str()); }
+
+    void recordEchoSession(int p_events)
+    {
+        EventJournal journal(path, codecs, 4);
+        NullPort sink;
+        JournalingPort port(journal, 1, sink);
+        EchoHandler echo(port, 1);
+        JournalingEventHandler handler(journal, echo);
+
+        for (int i = 0; i < p_events; ++i) {
+            handler.receive(std::make_unique<EventT<NumberMsg>>(NumberMsg{i}));
+        }
+    }
+
+    EventCodecRegistry codecs;
+    std::string const path = ::testing::TempDir() + "event_journal_test.bin";
+};
+
+} // namespace
+
+TEST_F(EventJournalTest, test_RecordedEvents_AreReadBackInOrder)
+{
+    recordEchoSession(100);
+
+    EventJournalReader reader(path);
+    ASSERT_EQ(200u, reader.events());
+
+    auto position = reader.begin();
+    EventJournalReader::Entry entry;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(reader.read(position, entry));
+        EXPECT_EQ(JOURNAL_INPUT_CHANNEL, entry.channel);
+        EXPECT_EQ(i, payload<NumberMsg>(*codecs.decode(entry.messageId, entry.payload, entry.payloadSize)).value);
+
+        ASSERT_TRUE(reader.read(position, entry));
+        EXPECT_EQ(1u, entry.channel);
+        EXPECT_EQ(2u * i + 1, entry.sequence);
+    }
+    EXPECT_FALSE(reader.read(position, entry));
+}
+
+TEST_F(EventJournalTest, test_ReceiveBatch_JournalsEachEventOnceAndForwardsTheBatch)
+{
+    BatchHandler batchHandler(1);
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < 4; ++i) {
+        events.push_back(std::make_unique<EventT<NumberMsg>>(NumberMsg{i}));
+    }
+    {
+        EventJournal journal(path, codecs);
+        JournalingEventHandler sut(journal, batchHandler);
+
+        EXPECT_THROW(sut.receiveBatch(events.data(), events.size()), std::runtime_error);
+    }
+
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), batchHandler.values);
+    EXPECT_EQ((std::vector<std::size_t>{4, 2}), batchHandler.batches);
+    for (auto const& event : events) {
+        EXPECT_EQ(nullptr, event);
+    }
+
+    EventJournalReader reader(path);
+    auto position = reader.begin();
+    EventJournalReader::Entry entry;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(reader.read(position, entry));
+        EXPECT_EQ(i, payload<NumberMsg>(*codecs.decode(entry.messageId, entry.payload, entry.payloadSize)).value);
+    }
+    EXPECT_FALSE(reader.read(position, entry));
+}
+
+TEST_F(EventJournalTest, test_PayloadsLongerThanOneRecord_StayContiguous)
+{
+    EventT<BlobMsg> blob;
+    for (std::size_t i = 0; i < sizeof(blob->bytes); ++i) {
+        blob->bytes[i] = static_cast<char>(i);
+    }
+    {
+        EventJournal journal(path, codecs);
+        journal.append(JOURNAL_INPUT_CHANNEL, blob);
+        journal.append(JOURNAL_INPUT_CHANNEL, EventT<NumberMsg>(NumberMsg{7}));
+    }
+
+    EventJournalReader reader(path);
+    auto position = reader.begin();
+    EventJournalReader::Entry entry;
+
+    ASSERT_TRUE(reader.read(position, entry));
+    ASSERT_EQ(sizeof(BlobMsg), entry.payloadSize);
+    EXPECT_EQ(0, std::memcmp(blob->bytes, entry.payload, entry.payloadSize));
+
+    ASSERT_TRUE(reader.read(position, entry));
+    EXPECT_EQ(NumberMsg::MESSAGE_ID, entry.messageId);
+}
+
+TEST_F(EventJournalTest, test_PayloadsOver64KiB_AreJournaled)
+{
+    auto const large = std::make_unique<EventT<LargeMsg>>();
+    (*large)->bytes[sizeof(LargeMsg) - 1] = 'x';
+    {
+        EventJournal journal(path, codecs);
+        journal.append(1, *large);
+    }
+
+    EventJournalReader reader(path);
+    auto position = reader.begin();
+    EventJournalReader::Entry entry;
+
+    ASSERT_TRUE(reader.read(position, entry));
+    ASSERT_EQ(sizeof(LargeMsg), entry.payloadSize);
+    EXPECT_EQ('x', entry.payload[sizeof(LargeMsg) - 1]);
+    EXPECT_FALSE(reader.read(position, entry));
+}
+
+TEST_F(EventJournalTest, test_ReplayOfSameHandler_Matches)
+{
+    recordEchoSession(1000);
+
+    EventJournalReader reader(path);
+    JournalReplay replay(reader, codecs);
+    EchoHandler fresh(replay.port(1), 1);
+    auto const result = replay.run(fresh);
+
+    EXPECT_EQ(1000u, result.inputs);
+    EXPECT_EQ(1000u, result.outputs);
+    EXPECT_EQ(0u, result.mismatches);
+}
+
+TEST_F(EventJournalTest, test_ReplayOfChangedHandler_ReportsFirstMismatch)
+{
+    recordEchoSession(10);
+
+    EventJournalReader reader(path);
+    JournalReplay replay(reader, codecs);
+    EchoHandler changed(replay.port(1), 2);
+    auto const result = replay.run(changed);
+
+    EXPECT_EQ(10u, result.mismatches);
+    EXPECT_EQ(1u, result.firstMismatch);
+}
@@ -0,0 +1,157 @@
+#include "EventRouter.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct Tick
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x01;
+};
+
+struct Cells
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x02;
+
+    std::vector<int> values;
+};
+
+struct Far
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x1000;
+};
+
+class RecordingPort : public IPort
+{
+public:
+    void send(std::unique_ptr<Event> p_event) override { events.push_back(std::move(p_event)); }
+
+    std::vector<std::unique_ptr<Event>> events;
+};
+
+class CountingPort : public IPort
+{
+public:
+    void send(std::unique_ptr<Event>) override { count.fetch_add(1, std::memory_order_relaxed); }
+
+    std::atomic<int> count{0};
+};
+
+} // namespace
+
+TEST(EventRouterTest, test_Send_ReachesSubscribersOfMessageIdOnly)
+{
+    EventRouter l_router;
+    RecordingPort l_ticks;
+    RecordingPort l_cells;
+    l_router.subscribe(Tick::MESSAGE_ID, l_ticks);
+    l_router.subscribe(Cells::MESSAGE_ID, l_cells);
+
+    l_router.send(std::make_unique<EventT<Tick>>());
+    l_router.send(std::make_unique<EventT<Tick>>());
+
+    EXPECT_EQ(2u, l_ticks.events.size());
+    EXPECT_TRUE(l_cells.events.empty());
+}
+
+TEST(EventRouterTest, test_SubscribeAll_ReceivesEverythingIncludingIdsBeyondTable)
+{
+    EventRouter l_router(16);
+    RecordingPort l_logger;
+    l_router.subscribeAll(l_logger);
+
+    l_router.send(std::make_unique<EventT<Tick>>());
+    l_router.send(std::make_unique<EventT<Far>>());
+
+    ASSERT_EQ(2u, l_logger.events.size());
+    EXPECT_EQ(Far::MESSAGE_ID, l_logger.events[1]->getMessageId());
+    EXPECT_THROW(l_router.subscribe(Far::MESSAGE_ID, l_logger), std::out_of_range);
+}
+
+TEST(EventRouterTest, test_SeveralReceivers_ShareOnePayload)
+{
+    EventRouter l_router;
+    RecordingPort l_first;
+    RecordingPort l_second;
+    RecordingPort l_third;
+    l_router.subscribe(Cells::MESSAGE_ID, l_first);
+    l_router.subscribe(Cells::MESSAGE_ID, l_second);
+    l_router.subscribeAll(l_third);
+
+    l_router.send(std::make_unique<EventT<Cells>>(Cells{{1, 2, 3}}));
+
+    ASSERT_EQ(1u, l_first.events.size());
+    ASSERT_EQ(1u, l_second.events.size());
+    ASSERT_EQ(1u, l_third.events.size());
+    Event const& l_firstEvent = *l_first.events[0];
+    Event const& l_thirdEvent = *l_third.events[0];
+    EXPECT_EQ(3u, payload<Cells>(l_firstEvent).values.size());
+    EXPECT_EQ(&payload<Cells>(l_firstEvent), &payload<Cells>(l_thirdEvent));
+}
+
+TEST(EventRouterTest, test_Unsubscribe_StopsDelivery)
+{
+    EventRouter l_router;
+    RecordingPort l_port;
+    l_router.subscribe(Tick::MESSAGE_ID, l_port);
+    l_router.subscribeAll(l_port);
+
+    l_router.send(std::make_unique<EventT<Tick>>());
+    l_router.unsubscribe(l_port);
+    l_router.send(std::make_unique<EventT<Tick>>());
+
+    EXPECT_EQ(2u, l_port.events.size());
+}
+
+TEST(EventRouterTest, test_ThrowingSubscriber_DoesNotBlockSubscriptions)
+{
+    struct ThrowingPort : IPort
+    {
+        void send(std::unique_ptr<Event>) override { throw std::runtime_error("subscriber failed"); }
+    };
+
+    EventRouter l_router;
+    ThrowingPort l_throwing;
+    RecordingPort l_port;
+    l_router.subscribe(Tick::MESSAGE_ID, l_throwing);
+
+    EXPECT_THROW(l_router.send(std::make_unique<EventT<Tick>>()), std::runtime_error);
+
+    l_router.unsubscribe(l_throwing);
+    l_router.subscribe(Tick::MESSAGE_ID, l_port);
+    l_router.send(std::make_unique<EventT<Tick>>());
+    EXPECT_EQ(1u, l_port.events.size());
+}
+
+TEST(EventRouterTest, test_SubscriptionsChangeWhileSending)
+{
+    EventRouter l_router;
+    CountingPort l_steady;
+    CountingPort l_flapping;
+    l_router.subscribe(Tick::MESSAGE_ID, l_steady);
+
+    constexpr int l_events = 20000;
+    std::thread l_sender([&] {
+        for (int i = 0; i < l_events; ++i) {
+            l_router.send(std::make_unique<EventT<Tick>>());
+        }
+    });
+    for (int i = 0; i < 200; ++i) {
+        l_router.subscribe(Tick::MESSAGE_ID, l_flapping);
+        l_router.unsubscribe(l_flapping);
+    }
+    l_sender.join();
+
+    EXPECT_EQ(l_events, l_steady.count.load());
+    EXPECT_LE(l_flapping.count.load(), l_events);
+}
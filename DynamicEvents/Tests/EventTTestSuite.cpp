@@ -0,0 +1,93 @@
+#include "EventT.hpp"
+#include "EventPool.hpp"
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct SmallMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x01;
+
+    int value;
+};
+
+struct LargeMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x02;
+
+    char data[EventPool::MAX_POOLED_SIZE];
+};
+
+} // namespace
+
+TEST(EventTTest, test_PayloadIsStoredInline)
+{
+    EXPECT_LE(sizeof(EventT<SmallMsg>), sizeof(Event) + sizeof(SmallMsg) + alignof(SmallMsg));
+}
+
+TEST(EventTTest, test_Clone_CopiesPayloadAndMessageId)
+{
+    EventT<SmallMsg> original;
+    original->value = 42;
+
+    auto copy = original.clone();
+    original->value = 0;
+
+    EXPECT_EQ(SmallMsg::MESSAGE_ID, copy->getMessageId());
+    EXPECT_EQ(42, payload<SmallMsg>(*copy).value);
+}
+
+TEST(EventTTest, test_EventCast_ChecksMessageId)
+{
+    EventT<SmallMsg> small(SmallMsg{7});
+    Event& event = small;
+    Event const& constEvent = small;
+
+    ASSERT_NE(nullptr, event_cast<SmallMsg>(event));
+    EXPECT_EQ(7, event_cast<SmallMsg>(constEvent)->get().value);
+    EXPECT_EQ(nullptr, event_cast<LargeMsg>(event));
+    EXPECT_EQ(nullptr, event_cast<LargeMsg>(constEvent));
+}
+
+#ifdef DYNAMIC_EVENTS_POOL
+TEST(EventTTest, test_ReleasedEvent_IsReusedForNextEventOfSameSize)
+{
+    auto first = std::make_unique<EventT<SmallMsg>>();
+    void const* block = first.get();
+    first.reset();
+
+    auto second = std::make_unique<EventT<SmallMsg>>();
+
+    EXPECT_EQ(block, second.get());
+}
+
+TEST(EventTTest, test_EventReleasedOnOtherThread_IsReusedByTheThreadThatCreatedIt)
+{
+    // A fresh thread, so that nothing else is cached for the size.
+    std::thread([] {
+        auto first = std::make_unique<EventT<SmallMsg>>();
+        void const* block = first.get();
+        std::thread([&first] { first.reset(); }).join();
+
+        auto second = std::make_unique<EventT<SmallMsg>>();
+
+        EXPECT_EQ(block, second.get());
+    }).join();
+}
+
+TEST(EventTTest, test_EventsLargerThanPooledSize_StillWork)
+{
+    auto large = std::make_unique<EventT<LargeMsg>>();
+    (*large)->data[EventPool::MAX_POOLED_SIZE - 1] = 'x';
+
+    auto copy = large->clone();
+
+    EXPECT_EQ('x', payload<LargeMsg>(*copy).data[EventPool::MAX_POOLED_SIZE - 1]);
+}
+#endif
@@ -0,0 +1,103 @@
+#include "LatencyHistogram.hpp"
+#include "PerThread.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+TEST(LatencyHistogramTest, test_SmallValues_AreExact)
+{
+    LatencyHistogram l_histogram;
+    for (std::uint64_t value = 1; value <= 10; ++value) {
+        l_histogram.record(value);
+    }
+
+    EXPECT_EQ(10u, l_histogram.count());
+    EXPECT_EQ(55u, l_histogram.sum());
+    EXPECT_EQ(10u, l_histogram.max());
+    EXPECT_EQ(5u, l_histogram.percentile(50));
+    EXPECT_EQ(10u, l_histogram.percentile(100));
+}
+
+TEST(LatencyHistogramTest, test_LargeValues_StayWithinBucketPrecision)
+{
+    LatencyHistogram l_histogram;
+    l_histogram.record(1000000);
+
+    auto const p50 = l_histogram.percentile(50);
+    EXPECT_LE(p50, 1000000u);
+    EXPECT_GT(p50, 1000000u - 1000000u / LatencyHistogram::SUB_BUCKETS);
+    EXPECT_EQ(LatencyHistogram::BUCKETS - 1, LatencyHistogram::bucketOf(~std::uint64_t{0}));
+}
+
+TEST(LatencyHistogramTest, test_Merge_CombinesSamples)
+{
+    LatencyHistogram l_first;
+    LatencyHistogram l_second;
+    l_first.record(3);
+    l_second.record(7);
+    l_second.record(9);
+
+    l_first.merge(l_second);
+
+    EXPECT_EQ(3u, l_first.count());
+    EXPECT_EQ(19u, l_first.sum());
+    EXPECT_EQ(9u, l_first.max());
+    EXPECT_EQ(7u, l_first.percentile(50));
+}
+
+TEST(PerThreadTest, test_EachThreadGetsItsOwnValue)
+{
+    PerThread<int> l_counters;
+    std::vector<std::thread> l_threads;
+    for (int i = 0; i < 4; ++i) {
+        l_threads.emplace_back([&l_counters] {
+            for (int j = 0; j < 1000; ++j) {
+                ++l_counters.local();
+            }
+        });
+    }
+    for (auto& thread : l_threads) {
+        thread.join();
+    }
+
+    int l_slots = 0;
+    int l_total = 0;
+    l_counters.forEach([&](int p_value) {
+        ++l_slots;
+        l_total += p_value;
+    });
+    EXPECT_EQ(4, l_slots);
+    EXPECT_EQ(4000, l_total);
+}
+
+TEST(PerThreadTest, test_AlternatingInstances_KeepOneSlotPerThread)
+{
+    PerThread<int> l_first;
+    PerThread<int> l_second;
+    for (int i = 0; i < 100; ++i) {
+        ++l_first.local();
+        ++l_second.local();
+    }
+
+    int l_slots = 0;
+    l_first.forEach([&](int p_value) {
+        ++l_slots;
+        EXPECT_EQ(100, p_value);
+    });
+    EXPECT_EQ(1, l_slots);
+}
+
+TEST(PerThreadTest, test_InstanceAtReusedIndex_StartsFresh)
+{
+    {
+        PerThread<int> l_gone;
+        l_gone.local() = 42;
+    }
+    PerThread<int> l_next;
+
+    EXPECT_EQ(0, l_next.local());
+}
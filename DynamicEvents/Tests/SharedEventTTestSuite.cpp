@@ -0,0 +1,72 @@
+#include "SharedEventT.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct Cells
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x05;
+
+    std::vector<int> values;
+};
+
+} // namespace
+
+TEST(SharedEventTTest, test_Clone_SharesPayload)
+{
+    SharedEventT<Cells> const l_event(Cells{{1, 2, 3}});
+
+    std::unique_ptr<Event const> const l_clone = l_event.clone();
+
+    EXPECT_EQ(Cells::MESSAGE_ID, l_clone->getMessageId());
+    EXPECT_EQ(&payload<Cells>(l_event), &payload<Cells>(*l_clone));
+    EXPECT_TRUE(l_event.isShared());
+}
+
+TEST(SharedEventTTest, test_Share_LeavesTheEventHoldingThePayload)
+{
+    SharedEventT<Cells> l_event(Cells{{1, 2, 3}});
+
+    auto const l_shared = l_event.share();
+
+    EXPECT_EQ(&*l_event, &payload<Cells>(static_cast<Event const&>(*l_shared)));
+    EXPECT_EQ(3u, l_event->values.size());
+    EXPECT_EQ(3u, payload<Cells>(*l_event.clone()).values.size());
+}
+
+TEST(SharedEventTTest, test_MutableAccess_CopiesSharedPayload)
+{
+    SharedEventT<Cells> l_event(Cells{{1, 2, 3}});
+    auto l_clone = l_event.clone();
+
+    payload<Cells>(*l_clone).values.push_back(4);
+
+    EXPECT_EQ(3u, l_event->values.size());
+    EXPECT_EQ(4u, payload<Cells>(static_cast<Event const&>(*l_clone)).values.size());
+    EXPECT_FALSE(l_event.isShared());
+}
+
+TEST(SharedEventTTest, test_MutableAccess_OfSoleOwner_DoesNotCopy)
+{
+    SharedEventT<Cells> l_event(Cells{{1, 2, 3}});
+    auto const* l_before = &*l_event;
+
+    payload<Cells>(l_event).values.push_back(4);
+
+    EXPECT_EQ(l_before, &*l_event);
+    EXPECT_EQ(4u, l_event->values.size());
+}
+
+TEST(SharedEventTTest, test_PayloadAccess_WorksForBothRepresentations)
+{
+    EventT<Cells> const l_owned(Cells{{7}});
+    SharedEventT<Cells> const l_shared(Cells{{7}});
+
+    EXPECT_EQ(payload<Cells>(l_owned).values, payload<Cells>(l_shared).values);
+}
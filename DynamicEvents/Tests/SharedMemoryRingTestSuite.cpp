@@ -0,0 +1,193 @@
+#include "SharedMemoryRing.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct SequenceMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x01;
+
+    int sequence;
+};
+
+struct TextMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x02;
+
+    std::string text;
+};
+
+void encodeText(Event const& p_event, std::vector<std::uint8_t>& p_bytes)
+{
+    auto const& text = payload<TextMsg>(p_event).text;
+    p_bytes.insert(p_bytes.end(), text.begin(), text.end());
+}
+
+std::unique_ptr<Event> decodeText(std::uint8_t const* p_bytes, std::size_t p_size)
+{
+    return std::make_unique<EventT<TextMsg>>(TextMsg{std::string(p_bytes, p_bytes + p_size)});
+}
+
+EventCodecRegistry testCodecs()
+{
+    EventCodecRegistry codecs;
+    codecs.add<SequenceMsg>();
+    codecs.add(TextMsg::MESSAGE_ID, &encodeText, &decodeText);
+    return codecs;
+}
+
+class RecordingHandler : public IEventHandler
+{
+public:
+    void receive(std::unique_ptr<Event> p_event) override { received.push_back(std::move(p_event)); }
+
+    std::vector<std::unique_ptr<Event>> received;
+};
+
+std::string ringName(char const* p_test)
+{
+    return "/SharedMemoryRingTest." + std::string(p_test) + "." + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST(SharedMemoryRingTest, test_Records_WrapAroundTheEndInOrder)
+{
+    auto ring = SharedMemoryRing::create(ringName("Wrap"), 64);
+
+    int next = 0;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            auto const size = static_cast<std::size_t>(1 + (round + i) % 7);
+            auto const destination = ring.tryReserve(SequenceMsg::MESSAGE_ID, size);
+            ASSERT_NE(nullptr, destination);
+            std::memset(destination, next++, size);
+        }
+        ring.publish();
+
+        std::vector<int> seen;
+        ring.consume([&](std::uint32_t p_messageId, std::uint8_t const* p_payload, std::size_t) {
+            EXPECT_EQ(SequenceMsg::MESSAGE_ID, p_messageId);
+            seen.push_back(*p_payload);
+        });
+        EXPECT_EQ((std::vector<int>{next - 3, next - 2, next - 1}), seen);
+    }
+}
+
+TEST(SharedMemoryRingTest, test_FullRing_RejectsUntilConsumed)
+{
+    auto ring = SharedMemoryRing::create(ringName("Full"), 64);
+    auto const codecs = testCodecs();
+    SharedMemoryPort port(ring, codecs, SharedMemoryPort::Backpressure::Reject);
+
+    for (int i = 0; i < 5; ++i) {
+        port.send(std::make_unique<EventT<SequenceMsg>>(SequenceMsg{i}));
+    }
+    EXPECT_EQ(1u, port.rejected());
+
+    RecordingHandler handler;
+    SharedMemoryReader reader(ring, codecs, handler);
+    EXPECT_EQ(4u, reader.poll());
+    EXPECT_EQ(3, payload<SequenceMsg>(*handler.received.back()).sequence);
+
+    port.send(std::make_unique<EventT<SequenceMsg>>(SequenceMsg{5}));
+    EXPECT_EQ(1u, port.rejected());
+}
+
+TEST(SharedMemoryRingTest, test_ThrowingHandler_ConsumesUpToTheFailedEvent)
+{
+    // Fails on sequence 1, once.
+    class FailingHandler : public RecordingHandler
+    {
+    public:
+        void receive(std::unique_ptr<Event> p_event) override
+        {
+            if (payload<SequenceMsg>(*p_event).sequence == 1) {
+                throw std::runtime_error("handler failed");
+            }
+            RecordingHandler::receive(std::move(p_event));
+        }
+    };
+
+    auto ring = SharedMemoryRing::create(ringName("Throwing"), 256);
+    auto const codecs = testCodecs();
+    SharedMemoryPort port(ring, codecs);
+    for (int i = 0; i < 4; ++i) {
+        port.send(std::make_unique<EventT<SequenceMsg>>(SequenceMsg{i}));
+    }
+
+    FailingHandler handler;
+    SharedMemoryReader reader(ring, codecs, handler);
+    EXPECT_THROW(reader.poll(), std::runtime_error);
+    EXPECT_EQ(2u, reader.poll());
+
+    std::vector<int> l_sequences;
+    for (auto const& event : handler.received) {
+        l_sequences.push_back(payload<SequenceMsg>(*event).sequence);
+    }
+    EXPECT_EQ((std::vector<int>{0, 2, 3}), l_sequences);
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(SharedMemoryRingTest, test_OpenWithWrongName_Throws)
+{
+    EXPECT_THROW(SharedMemoryRing::open(ringName("Missing")), std::system_error);
+    EXPECT_THROW(SharedMemoryRing::create(ringName("Small"), 100), std::invalid_argument);
+}
+
+// The reader runs in a forked process that attaches by name and goes to sleep on the empty ring
+// before the writer starts, so it relies on the futex wake-up.
+TEST(SharedMemoryRingTest, test_TwoProcesses_ReceiveAllEventsInOrder)
+{
+    constexpr int events = 20000;
+    auto const name = ringName("TwoProcesses");
+    auto ring = SharedMemoryRing::create(name, 4096);
+    auto const codecs = testCodecs();
+
+    auto const child = ::fork();
+    ASSERT_NE(-1, child);
+    if (child == 0) {
+        auto reader_ring = SharedMemoryRing::open(name);
+        RecordingHandler handler;
+        SharedMemoryReader reader(reader_ring, codecs, handler);
+        while (handler.received.size() < events + 1) {
+            if (not reader.waitAndPoll(std::chrono::seconds(10))) {
+                ::_exit(2);
+            }
+        }
+
+        int expected = 0;
+        for (int i = 0; i < events; ++i) {
+            if (payload<SequenceMsg>(*handler.received[i]).sequence != expected++) {
+                ::_exit(3);
+            }
+        }
+        ::_exit(payload<TextMsg>(*handler.received.back()).text == "done" ? 0 : 4);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    SharedMemoryPort port(ring, codecs);
+    for (int i = 0; i < events; ++i) {
+        port.send(std::make_unique<EventT<SequenceMsg>>(SequenceMsg{i}));
+    }
+    port.send(std::make_unique<EventT<TextMsg>>(TextMsg{"done"}));
+
+    int status = 0;
+    ASSERT_EQ(child, ::waitpid(child, &status, 0));
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(0, WEXITSTATUS(status));
+    EXPECT_LE(1u, ring.wakeups());
+}
@@ -0,0 +1,82 @@
+#include "TypedChannel.hpp"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct Ping
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x01;
+
+    int value;
+};
+
+struct Pong
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x02;
+};
+
+struct Other
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x03;
+};
+
+using PingPong = TypedChannel<Ping, Pong>;
+
+struct RecordingPort : IPort
+{
+    void send(std::unique_ptr<Event> p_event) override { events.push_back(std::move(p_event)); }
+
+    std::vector<std::unique_ptr<Event>> events;
+};
+
+std::string describe(PingPong::Message const& p_message)
+{
+    return std::visit(Overloaded{[](Ping const& p_ping) { return "ping " + std::to_string(p_ping.value); },
+                                 [](Pong const&) { return std::string("pong"); }},
+                      p_message);
+}
+
+} // namespace
+
+static_assert(PingPong::carries<Ping> and not PingPong::carries<Other>);
+
+TEST(TypedChannelTest, test_Visit_DispatchesOnAlternative)
+{
+    EXPECT_EQ("ping 7", describe(Ping{7}));
+    EXPECT_EQ("pong", describe(Pong{}));
+}
+
+TEST(TypedChannelTest, test_FromEvent_CopiesPayloadOfKnownEvent)
+{
+    auto const l_message = PingPong::fromEvent(EventT<Ping>(Ping{42}));
+
+    ASSERT_TRUE(l_message.has_value());
+    ASSERT_TRUE(std::holds_alternative<Ping>(*l_message));
+    EXPECT_EQ(42, std::get<Ping>(*l_message).value);
+}
+
+TEST(TypedChannelTest, test_FromEvent_RejectsForeignEvent)
+{
+    EXPECT_FALSE(PingPong::fromEvent(EventT<Other>()).has_value());
+}
+
+TEST(TypedChannelTest, test_EventPortAdapter_SendsDynamicEvents)
+{
+    RecordingPort l_port;
+    EventPortAdapter<PingPong> l_adapter(l_port);
+
+    l_adapter.send(Ping{5});
+    l_adapter.send(Pong{});
+
+    ASSERT_EQ(2u, l_port.events.size());
+    EXPECT_EQ(Ping::MESSAGE_ID, l_port.events[0]->getMessageId());
+    EXPECT_EQ(5, payload<Ping>(*l_port.events[0]).value);
+    EXPECT_EQ(Pong::MESSAGE_ID, l_port.events[1]->getMessageId());
+}
@@ -0,0 +1,138 @@
+#include "WireFrame.hpp"
+
+#include <string>
+#include <vector>
+
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace
+{
+
+struct SequenceMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x01;
+
+    int sequence;
+};
+
+struct TextMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x02;
+
+    std::string text;
+};
+
+struct TickMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x03;
+};
+
+void encodeText(Event const& p_event, std::vector<std::uint8_t>& p_bytes)
+{
+    auto const& text = payload<TextMsg>(p_event).text;
+    p_bytes.insert(p_bytes.end(), text.begin(), text.end());
+}
+
+std::unique_ptr<Event> decodeText(std::uint8_t const* p_bytes, std::size_t p_size)
+{
+    return std::make_unique<EventT<TextMsg>>(TextMsg{std::string(p_bytes, p_bytes + p_size)});
+}
+
+struct WireFrameTest : Test
+{
+    WireFrameTest()
+    {
+        codecs.add<SequenceMsg>();
+        codecs.add(TextMsg::MESSAGE_ID, &encodeText, &decodeText);
+        codecs.add<TickMsg>();
+    }
+
+    // A SequenceMsg{7}, a TextMsg "hello" and a TickMsg.
+    std::vector<std::uint8_t> threeFrames()
+    {
+        std::vector<std::uint8_t> bytes;
+        encodeFrame(codecs, EventT<SequenceMsg>(SequenceMsg{7}), bytes);
+        encodeFrame(codecs, EventT<TextMsg>(TextMsg{"hello"}), bytes);
+        encodeFrame(codecs, EventT<TickMsg>(), bytes);
+        return bytes;
+    }
+
+    EventCodecRegistry codecs;
+};
+
+TEST_F(WireFrameTest, test_Frames_StreamBackToBack)
+{
+    auto const bytes = threeFrames();
+    ASSERT_EQ(3 * sizeof(WireFrameHeader) + sizeof(SequenceMsg) + 5, bytes.size());
+
+    WireFrameReader sut(bytes.data(), bytes.size());
+    WireFrameView frame;
+
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_EQ(7, frame.as<SequenceMsg>().sequence);
+
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_TRUE(frame.is<TextMsg>());
+    EXPECT_EQ("hello", std::string(frame.payload, frame.payload + frame.payloadSize));
+    auto const decoded = codecs.decode(frame.messageId, frame.payload, frame.payloadSize);
+    EXPECT_EQ("hello", payload<TextMsg>(*decoded).text);
+
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_TRUE(frame.is<TickMsg>());
+    EXPECT_EQ(0u, frame.payloadSize);
+
+    EXPECT_FALSE(sut.next(frame));
+    EXPECT_EQ(bytes.size(), sut.consumed());
+}
+
+TEST_F(WireFrameTest, test_FrameCutByBufferEnd_IsLeftForTheNextBuffer)
+{
+    auto const bytes = threeFrames();
+
+    for (std::size_t cut = 0; cut <= bytes.size(); ++cut) {
+        std::vector<std::uint32_t> l_ids;
+        WireFrameView frame;
+
+        WireFrameReader first(bytes.data(), cut);
+        while (first.next(frame)) {
+            l_ids.push_back(frame.messageId);
+        }
+        std::vector<std::uint8_t> const rest(bytes.begin() + first.consumed(), bytes.end());
+        WireFrameReader second(rest.data(), rest.size());
+        while (second.next(frame)) {
+            l_ids.push_back(frame.messageId);
+        }
+
+        EXPECT_EQ((std::vector<std::uint32_t>{SequenceMsg::MESSAGE_ID, TextMsg::MESSAGE_ID, TickMsg::MESSAGE_ID}), l_ids)
+            << "cut at " << cut;
+    }
+}
+
+TEST_F(WireFrameTest, test_View_RejectsWrongTypeOrOffset)
+{
+    auto const bytes = threeFrames();
+    WireFrameReader sut(bytes.data(), bytes.size());
+    WireFrameView frame;
+    ASSERT_TRUE(sut.next(frame));
+
+    EXPECT_THROW(frame.as<TickMsg>(), std::invalid_argument);
+    EXPECT_EQ(7, frame.read<int>(0));
+    EXPECT_THROW(frame.read<int>(1), std::out_of_range);
+    EXPECT_THROW(frame.read<int>(SIZE_MAX), std::out_of_range);
+}
+
+TEST_F(WireFrameTest, test_FrameOfOtherVersion_IsRejected)
+{
+    auto bytes = threeFrames();
+    bytes[3] = WireFrameHeader::VERSION + 1;
+
+    WireFrameReader sut(bytes.data(), bytes.size());
+    WireFrameView frame;
+    EXPECT_THROW(sut.next(frame), std::invalid_argument);
+}
+
+} // namespace
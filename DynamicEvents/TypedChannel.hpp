@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "EventT.hpp"
+#include "IPort.hpp"
+
+// A closed set of message types passed by value as a std::variant. Senders and receivers agree
+// on the list at compile time, so dispatch is a std::visit over the alternatives instead of a
+// virtual getMessageId() lookup, and nothing is allocated per message. toEvent()/fromEvent()
+// bridge to the dynamic Event world for ports that still speak unique_ptr<Event>.
+template <class... Messages>
+class TypedChannel
+{
+    static_assert(sizeof...(Messages) > 0, "A channel needs at least one message type!");
+
+public:
+    using Message = std::variant<Messages...>;
+
+    class IPort
+    {
+    public:
+        virtual ~IPort() = default;
+        virtual void send(Message const& p_message) = 0;
+    };
+
+    class IHandler
+    {
+    public:
+        virtual ~IHandler() = default;
+        virtual void receive(Message const& p_message) = 0;
+    };
+
+    template <class T>
+    static constexpr bool carries = (std::is_same_v<T, Messages> or ...);
+
+    static std::unique_ptr<Event> toEvent(Message const& p_message)
+    {
+        return std::visit(
+            [](auto const& p_payload) -> std::unique_ptr<Event> {
+                using T = std::decay_t<decltype(p_payload)>;
+                return std::make_unique<EventT<T>>(p_payload);
+            },
+            p_message);
+    }
+
+    // Copies the payload out of an event of one of the channel's types, or returns nullopt.
+    static std::optional<Message> fromEvent(Event const& p_event)
+    {
+        std::optional<Message> message;
+        auto const id = p_event.getMessageId();
+        (void)((id == Messages::MESSAGE_ID and
+                (message.emplace(std::in_place_type<Messages>, payload<Messages>(p_event)), true)) or ...);
+        return message;
+    }
+
+private:
+    static constexpr bool uniqueMessageIds()
+    {
+        std::uint32_t const ids[] = {Messages::MESSAGE_ID...};
+        for (std::size_t i = 0; i < sizeof...(Messages); ++i) {
+            for (std::size_t j = i + 1; j < sizeof...(Messages); ++j) {
+                if (ids[i] == ids[j]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static_assert(uniqueMessageIds(), "Messages in a channel must have distinct MESSAGE_IDs!");
+};
+
+// Forwards typed messages to a port that takes dynamic events.
+template <class Channel>
+class EventPortAdapter : public Channel::IPort
+{
+public:
+    explicit EventPortAdapter(::IPort& p_port)
+        : m_port(p_port)
+    {}
+
+    void send(typename Channel::Message const& p_message) override
+    {
+        m_port.send(Channel::toEvent(p_message));
+    }
+
+private:
+    ::IPort& m_port;
+};
+
+// Builds a visitor out of lambdas: std::visit(Overloaded{[](A const&) {...}, [](B const&) {...}}, m).
+template <class... Visitors>
+struct Overloaded : Visitors...
+{
+    using Visitors::operator()...;
+};
+
+template <class... Visitors>
+Overloaded(Visitors...) -> Overloaded<Visitors...>;
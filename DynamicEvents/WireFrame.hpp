@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "EventCodecRegistry.hpp"
+
+// Events on the wire: each frame is an 8-byte header followed by the payload as encoded by the
+// EventCodecRegistry. The header starts with the payload length, so frames can be streamed back
+// to back and split at any byte; all fields are in host byte order.
+struct WireFrameHeader
+{
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::uint32_t MAX_PAYLOAD = (std::uint32_t{1} << 24) - 1;
+
+    std::uint32_t lengthAndVersion; // payload bytes in the low 24 bits, VERSION in the high 8
+    std::uint32_t messageId;
+
+    std::uint32_t length() const noexcept { return lengthAndVersion & MAX_PAYLOAD; }
+    std::uint32_t version() const noexcept { return lengthAndVersion >> 24; }
+};
+
+static_assert(sizeof(WireFrameHeader) == 8, "Wire frame headers are 8 bytes");
+
+// Adds one frame for p_event at the end of p_bytes.
+inline void encodeFrame(EventCodecRegistry const& p_codecs, Event const& p_event, std::vector<std::uint8_t>& p_bytes)
+{
+    auto const start = p_bytes.size();
+    p_bytes.resize(start + sizeof(WireFrameHeader));
+    p_codecs.append(p_event, p_bytes);
+
+    auto const length = p_bytes.size() - start - sizeof(WireFrameHeader);
+    if (length > WireFrameHeader::MAX_PAYLOAD) {
+        p_bytes.resize(start);
+        throw std::length_error("Payload of message " + std::to_string(p_event.getMessageId()) + " too long for a frame");
+    }
+
+    WireFrameHeader const header{static_cast<std::uint32_t>(length) | WireFrameHeader::VERSION << 24,
+                                 p_event.getMessageId()};
+    std::memcpy(p_bytes.data() + start, &header, sizeof(header));
+}
+
+// One decoded frame, pointing into the buffer it was read from: valid as long as that buffer is.
+// Payloads are read out by copy, so the buffer needs no particular alignment.
+struct WireFrameView
+{
+    std::uint32_t messageId;
+    std::uint8_t const* payload;
+    std::size_t payloadSize;
+
+    template <class T>
+    bool is() const noexcept
+    {
+        return messageId == T::MESSAGE_ID;
+    }
+
+    // The payload of a message registered with EventCodecRegistry::add<T>().
+    template <class T>
+    T as() const
+    {
+        if (not is<T>() or payloadSize != EventCodecRegistry::trivialSize<T>()) {
+            throw std::invalid_argument("Frame of message " + std::to_string(messageId) + " does not hold message " +
+                                        std::to_string(T::MESSAGE_ID));
+        }
+        return read<T>(0);
+    }
+
+    // A T stored p_offset bytes into the payload, such as one element of a payload made of Ts
+    // back to back.
+    template <class T>
+    T read(std::size_t p_offset) const
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read in place!");
+        T value{};
+        auto const size = EventCodecRegistry::trivialSize<T>();
+        if (p_offset > payloadSize or size > payloadSize - p_offset) {
+            throw std::out_of_range("Read past the payload of message " + std::to_string(messageId));
+        }
+        if (size) {
+            std::memcpy(&value, payload + p_offset, size);
+        }
+        return value;
+    }
+};
+
+// Walks the frames of a buffer without copying or allocating. A frame cut off at the end of the
+// buffer is left unread: consumed() tells where it starts, for the caller to carry it over to the
+// next buffer.
+class WireFrameReader
+{
+public:
+    WireFrameReader(std::uint8_t const* p_bytes, std::size_t p_size) noexcept
+        : m_bytes(p_bytes), m_size(p_size)
+    {}
+
+    // Throws std::invalid_argument on a frame of another version, which leaves the rest of the
+    // buffer unreadable.
+    bool next(WireFrameView& p_frame)
+    {
+        if (m_size - m_offset < sizeof(WireFrameHeader)) {
+            return false;
+        }
+
+        WireFrameHeader header;
+        std::memcpy(&header, m_bytes + m_offset, sizeof(header));
+        if (header.version() != WireFrameHeader::VERSION) {
+            throw std::invalid_argument("Unsupported wire frame version " + std::to_string(header.version()));
+        }
+        if (m_size - m_offset - sizeof(WireFrameHeader) < header.length()) {
+            return false;
+        }
+
+        p_frame = WireFrameView{header.messageId, m_bytes + m_offset + sizeof(WireFrameHeader), header.length()};
+        m_offset += sizeof(WireFrameHeader) + header.length();
+        return true;
+    }
+
+    std::size_t consumed() const noexcept { return m_offset; }
+
+private:
+    std::uint8_t const* m_bytes;
+    std::size_t m_size;
+    std::size_t m_offset = 0;
+};
@@ -0,0 +1,55 @@
+#include "GameEngine.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include "EventT.hpp"
+#include "IPort.hpp"
+#include "SnakeController.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+class NullPort : public IPort
+{
+public:
+    void send(std::unique_ptr<Event> p_evt) override { benchmark::DoNotOptimize(p_evt.get()); }
+};
+
+// Every game runs a one-segment snake around a 2x2 square, so it never dies.
+void BM_GameEngine_Ticks(benchmark::State& state)
+{
+    auto const games = static_cast<std::size_t>(state.range(0));
+    auto const threads = static_cast<std::size_t>(state.range(1));
+    constexpr int ticksPerRound = 64;
+
+    NullPort displayPort, foodPort, scorePort;
+    GameEngine engine(threads);
+    std::vector<GameEngine::Game*> hosted;
+    for (std::size_t i = 0; i < games; ++i) {
+        hosted.push_back(&engine.addGame(
+            std::make_unique<Controller>(displayPort, foodPort, scorePort, "W 10 10 F 9 9 S R 1 4 4")));
+    }
+
+    Direction const square[] = {Direction_RIGHT, Direction_DOWN, Direction_LEFT, Direction_UP};
+    for (auto _ : state) {
+        for (int tick = 0; tick < ticksPerRound; ++tick) {
+            for (auto* game : hosted) {
+                engine.post(*game, std::make_unique<EventT<DirectionInd>>(DirectionInd{square[tick % 4]}));
+                engine.post(*game, std::make_unique<EventT<TimeoutInd>>());
+            }
+        }
+        engine.waitIdle();
+    }
+
+    state.counters["ticks/s"] = benchmark::Counter(
+        static_cast<double>(engine.stats().ticks), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GameEngine_Ticks)
+    ->ArgsProduct({{1000, 10000}, {1, 2, 4, 8}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace Snake
@@ -0,0 +1,95 @@
+#include "TimerWheel.hpp"
+
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "EventT.hpp"
+#include "IEventHandler.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+constexpr std::size_t games = 100000;
+
+// Tick periods of 1 to 100 wheel ticks, the same for both benchmarks.
+std::vector<std::uint64_t> gamePeriods()
+{
+    std::mt19937 random(11);
+    std::uniform_int_distribution<std::uint64_t> period(1, 100);
+    std::vector<std::uint64_t> periods(games);
+    for (auto& p : periods) {
+        p = period(random);
+    }
+    return periods;
+}
+
+class CountingGame : public ControllerChannel::IHandler, public IEventHandler
+{
+public:
+    void receive(ControllerChannel::Message const&) override { ++ticks; }
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        benchmark::DoNotOptimize(p_event.get());
+        ++ticks;
+    }
+
+    std::uint64_t ticks = 0;
+};
+
+// One wheel tick over 100k games; the time per iteration is the timer overhead per 100k games.
+void BM_TimerWheel_100kGames(benchmark::State& state)
+{
+    auto const periods = gamePeriods();
+    std::vector<CountingGame> hosted(games);
+    TimerWheel wheel;
+    for (std::size_t i = 0; i < games; ++i) {
+        wheel.add(hosted[i], periods[i]);
+    }
+
+    std::size_t fired = 0;
+    for (auto _ : state) {
+        fired += wheel.advance();
+    }
+    state.counters["fired/tick"] = benchmark::Counter(static_cast<double>(fired), benchmark::Counter::kAvgIterations);
+    state.counters["time/fired"] = benchmark::Counter(static_cast<double>(fired),
+                                                    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_TimerWheel_100kGames)->Unit(benchmark::kMicrosecond);
+
+// The per-game timers it replaces: a heap of deadlines, and a fresh TimeoutInd for every firing.
+void BM_TimerHeap_100kGames(benchmark::State& state)
+{
+    auto const periods = gamePeriods();
+    std::vector<CountingGame> hosted(games);
+    using Deadline = std::pair<std::uint64_t, std::size_t>;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines;
+    for (std::size_t i = 0; i < games; ++i) {
+        deadlines.emplace(periods[i], i);
+    }
+
+    std::uint64_t now = 0;
+    std::size_t fired = 0;
+    for (auto _ : state) {
+        ++now;
+        while (deadlines.top().first == now) {
+            auto const game = deadlines.top().second;
+            deadlines.pop();
+            static_cast<IEventHandler&>(hosted[game]).receive(std::make_unique<EventT<TimeoutInd>>());
+            deadlines.emplace(now + periods[game], game);
+            ++fired;
+        }
+    }
+    state.counters["fired/tick"] = benchmark::Counter(static_cast<double>(fired), benchmark::Counter::kAvgIterations);
+    state.counters["time/fired"] = benchmark::Counter(static_cast<double>(fired),
+                                                    benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_TimerHeap_100kGames)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace Snake
@@ -0,0 +1,205 @@
+#include "GameEngine.hpp"
+
+#include <exception>
+
+#include "Event.hpp"
+#include "IEventHandler.hpp"
+#include "SnakeInterface.hpp"
+
+namespace Snake
+{
+namespace
+{
+thread_local GameEngine const* currentEngine = nullptr;
+thread_local std::size_t currentWorker = 0;
+} // namespace
+
+class GameEngine::Game
+{
+public:
+    explicit Game(std::unique_ptr<IEventHandler> p_handler)
+        : handler(std::move(p_handler))
+    {}
+
+    std::unique_ptr<IEventHandler> handler;
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Event>> inbox;
+    bool scheduled = false;
+};
+
+GameEngine::GameEngine(std::size_t p_workers)
+{
+    if (p_workers == 0) {
+        p_workers = 1;
+    }
+
+    for (std::size_t i = 0; i < p_workers; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < p_workers; ++i) {
+        m_threads.emplace_back(&GameEngine::workerLoop, this, i);
+    }
+}
+
+GameEngine::~GameEngine()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+GameEngine::Game& GameEngine::addGame(std::unique_ptr<IEventHandler> p_handler)
+{
+    std::lock_guard<std::mutex> lock(m_gamesMutex);
+    m_games.push_back(std::make_unique<Game>(std::move(p_handler)));
+    return *m_games.back();
+}
+
+void GameEngine::post(Game& p_game, std::unique_ptr<Event> p_event)
+{
+    m_outstanding.fetch_add(1);
+
+    bool wasIdle = false;
+    {
+        std::lock_guard<std::mutex> lock(p_game.mutex);
+        p_game.inbox.push_back(std::move(p_event));
+        wasIdle = not p_game.scheduled;
+        p_game.scheduled = true;
+    }
+
+    if (wasIdle) {
+        schedule(p_game);
+    }
+}
+
+void GameEngine::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_idleMutex);
+    m_idle.wait(lock, [this] { return m_outstanding.load() == 0; });
+}
+
+GameEngine::Stats GameEngine::stats() const
+{
+    Stats total{0, 0, 0};
+    for (auto const& worker : m_workers) {
+        total.events += worker->events.load(std::memory_order_relaxed);
+        total.ticks += worker->ticks.load(std::memory_order_relaxed);
+        total.failures += worker->failures.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void GameEngine::schedule(Game& p_game)
+{
+    auto const target = currentEngine == this
+        ? currentWorker
+        : m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+    {
+        Worker& worker = *m_workers[target];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.games.push_back(&p_game);
+    }
+
+    m_queuedGames.fetch_add(1);
+    if (m_sleepers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wakeUp.notify_one();
+    }
+}
+
+GameEngine::Game* GameEngine::popOrSteal(std::size_t p_worker)
+{
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        bool const own = i == 0;
+        Worker& victim = *m_workers[(p_worker + i) % m_workers.size()];
+
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (not victim.games.empty()) {
+            Game* game = own ? victim.games.front() : victim.games.back();
+            own ? victim.games.pop_front() : victim.games.pop_back();
+            m_queuedGames.fetch_sub(1);
+            return game;
+        }
+    }
+    return nullptr;
+}
+
+void GameEngine::run(Game& p_game, Worker& p_worker)
+{
+    std::vector<std::unique_ptr<Event>> batch;
+    {
+        std::lock_guard<std::mutex> lock(p_game.mutex);
+        batch.swap(p_game.inbox);
+    }
+
+    std::uint64_t ticks = 0;
+    for (auto const& event : batch) {
+        ticks += event->getMessageId() == TimeoutInd::MESSAGE_ID;
+    }
+
+    // A failing event leaves the ones after it in place, to be handed over again.
+    std::uint64_t failures = 0;
+    std::size_t next = 0;
+    while (next < batch.size()) {
+        try {
+            p_game.handler->receiveBatch(batch.data() + next, batch.size() - next);
+            next = batch.size();
+        } catch (std::exception const&) {
+            ++failures;
+            while (next < batch.size() and not batch[next]) {
+                ++next;
+            }
+        }
+    }
+
+    p_worker.events.fetch_add(batch.size(), std::memory_order_relaxed);
+    p_worker.ticks.fetch_add(ticks, std::memory_order_relaxed);
+    p_worker.failures.fetch_add(failures, std::memory_order_relaxed);
+
+    bool pending = false;
+    {
+        std::lock_guard<std::mutex> lock(p_game.mutex);
+        pending = not p_game.inbox.empty();
+        p_game.scheduled = pending;
+    }
+    if (pending) {
+        schedule(p_game);
+    }
+
+    if (m_outstanding.fetch_sub(batch.size()) == batch.size()) {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_idle.notify_all();
+    }
+}
+
+void GameEngine::workerLoop(std::size_t p_worker)
+{
+    currentEngine = this;
+    currentWorker = p_worker;
+
+    while (true) {
+        if (Game* game = popOrSteal(p_worker)) {
+            run(*game, *m_workers[p_worker]);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepers.fetch_add(1);
+        m_wakeUp.wait(lock, [this] { return m_stopping or m_queuedGames.load() > 0; });
+        m_sleepers.fetch_sub(1);
+
+        if (m_stopping) {
+            break;
+        }
+    }
+}
+
+} // namespace Snake
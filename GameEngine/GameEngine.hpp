@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Event;
+class IEventHandler;
+
+namespace Snake
+{
+
+// Hosts many games, each behind its own IEventHandler, on a fixed pool of worker threads.
+// A game with pending events sits in exactly one worker deque or is being run by exactly one
+// worker, so its events are handled in posting order and never concurrently. Idle workers steal
+// games from the other end of their peers' deques.
+class GameEngine
+{
+public:
+    class Game;
+
+    struct Stats
+    {
+        std::uint64_t events;
+        std::uint64_t ticks;
+        std::uint64_t failures;
+    };
+
+    explicit GameEngine(std::size_t p_workers = std::thread::hardware_concurrency());
+    ~GameEngine();
+
+    GameEngine(GameEngine const&) = delete;
+    GameEngine& operator=(GameEngine const&) = delete;
+
+    Game& addGame(std::unique_ptr<IEventHandler> p_handler);
+    void post(Game& p_game, std::unique_ptr<Event> p_event);
+
+    // Blocks until every event posted so far has been handled.
+    void waitIdle();
+
+    Stats stats() const;
+    std::size_t workers() const noexcept { return m_workers.size(); }
+
+private:
+    struct alignas(64) Worker
+    {
+        std::mutex mutex;
+        std::deque<Game*> games;
+
+        std::atomic<std::uint64_t> events{0};
+        std::atomic<std::uint64_t> ticks{0};
+        std::atomic<std::uint64_t> failures{0};
+    };
+
+    void schedule(Game& p_game);
+    Game* popOrSteal(std::size_t p_worker);
+    void run(Game& p_game, Worker& p_worker);
+    void workerLoop(std::size_t p_worker);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_gamesMutex;
+    std::deque<std::unique_ptr<Game>> m_games;
+
+    std::atomic<std::size_t> m_queuedGames{0};
+    std::atomic<std::size_t> m_sleepers{0};
+    std::atomic<std::size_t> m_nextWorker{0};
+    std::atomic<bool> m_stopping{false};
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeUp;
+
+    std::atomic<std::uint64_t> m_outstanding{0};
+    std::mutex m_idleMutex;
+    std::condition_variable m_idle;
+};
+
+} // namespace Snake
@@ -0,0 +1,136 @@
+#include "GameEngine.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "EventT.hpp"
+#include "IEventHandler.hpp"
+#include "SnakeInterface.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace Snake
+{
+namespace
+{
+
+struct SequenceMsg
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x1000;
+
+    int producer;
+    int sequence;
+};
+
+// Records what it receives and flags any overlapping or out-of-order delivery.
+class RecordingHandler : public IEventHandler
+{
+public:
+    void receive(std::unique_ptr<Event> p_event) override
+    {
+        if (m_busy.exchange(true)) {
+            overlapped = true;
+        }
+
+        if (p_event->getMessageId() == SequenceMsg::MESSAGE_ID) {
+            auto const& msg = payload<SequenceMsg>(*p_event);
+            auto& last = lastSequence[msg.producer];
+            if (msg.sequence != last + 1) {
+                outOfOrder = true;
+            }
+            last = msg.sequence;
+        }
+        ++received;
+
+        m_busy = false;
+    }
+
+    std::vector<int> lastSequence = std::vector<int>(8, -1);
+    int received = 0;
+    bool overlapped = false;
+    bool outOfOrder = false;
+
+private:
+    std::atomic<bool> m_busy{false};
+};
+
+class ThrowingHandler : public IEventHandler
+{
+public:
+    void receive(std::unique_ptr<Event>) override { throw std::runtime_error("unexpected"); }
+};
+
+} // namespace
+
+TEST(GameEngineTest, test_EventsOfOneGame_AreHandledInPostingOrder)
+{
+    GameEngine engine(4);
+    auto handler = std::make_unique<RecordingHandler>();
+    auto& recorder = *handler;
+    auto& game = engine.addGame(std::move(handler));
+
+    for (int i = 0; i < 10000; ++i) {
+        engine.post(game, std::make_unique<EventT<SequenceMsg>>(SequenceMsg{0, i}));
+    }
+    engine.waitIdle();
+
+    EXPECT_EQ(10000, recorder.received);
+    EXPECT_FALSE(recorder.outOfOrder);
+}
+
+TEST(GameEngineTest, test_ConcurrentProducers_GameIsNeverRunOnTwoThreadsAtOnce)
+{
+    GameEngine engine(4);
+    std::vector<RecordingHandler*> recorders;
+    std::vector<GameEngine::Game*> games;
+    for (int i = 0; i < 16; ++i) {
+        auto handler = std::make_unique<RecordingHandler>();
+        recorders.push_back(handler.get());
+        games.push_back(&engine.addGame(std::move(handler)));
+    }
+
+    std::vector<std::thread> producers;
+    for (int producer = 0; producer < 4; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (int i = 0; i < 2000; ++i) {
+                for (auto* game : games) {
+                    engine.post(*game, std::make_unique<EventT<SequenceMsg>>(SequenceMsg{producer, i}));
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    engine.waitIdle();
+
+    for (auto* recorder : recorders) {
+        EXPECT_EQ(8000, recorder->received);
+        EXPECT_FALSE(recorder->overlapped);
+        EXPECT_FALSE(recorder->outOfOrder);
+    }
+    EXPECT_EQ(16u * 8000u, engine.stats().events);
+}
+
+TEST(GameEngineTest, test_Stats_CountTicksAndFailedEvents)
+{
+    GameEngine engine(2);
+    auto& recorded = engine.addGame(std::make_unique<RecordingHandler>());
+    auto& failing = engine.addGame(std::make_unique<ThrowingHandler>());
+
+    engine.post(recorded, std::make_unique<EventT<TimeoutInd>>());
+    engine.post(recorded, std::make_unique<EventT<TimeoutInd>>());
+    engine.post(failing, std::make_unique<EventT<TimeoutInd>>());
+    engine.waitIdle();
+
+    auto const stats = engine.stats();
+    EXPECT_EQ(3u, stats.events);
+    EXPECT_EQ(3u, stats.ticks);
+    EXPECT_EQ(1u, stats.failures);
+}
+
+} // namespace Snake
@@ -0,0 +1,139 @@
+#include "TimerWheel.hpp"
+
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace Snake
+{
+namespace
+{
+
+// Records the wheel time of every TimeoutInd it gets.
+class TickRecorder : public ControllerChannel::IHandler
+{
+public:
+    explicit TickRecorder(TimerWheel& p_wheel)
+        : m_wheel(p_wheel)
+    {}
+
+    void receive(ControllerChannel::Message const& p_message) override
+    {
+        EXPECT_TRUE(std::holds_alternative<TimeoutInd>(p_message));
+        ticks.push_back(m_wheel.now());
+        if (onTick) {
+            onTick();
+        }
+    }
+
+    std::vector<std::uint64_t> ticks;
+    std::function<void()> onTick;
+
+private:
+    TimerWheel& m_wheel;
+};
+
+} // namespace
+
+TEST(TimerWheelTest, test_Games_FireAtTheirOwnPeriods)
+{
+    TimerWheel sut;
+    TickRecorder fast(sut), slow(sut);
+    sut.add(fast, 3);
+    sut.add(slow, 7);
+
+    EXPECT_EQ(6u, sut.advance(14));
+
+    EXPECT_EQ((std::vector<std::uint64_t>{3, 6, 9, 12}), fast.ticks);
+    EXPECT_EQ((std::vector<std::uint64_t>{7, 14}), slow.ticks);
+}
+
+TEST(TimerWheelTest, test_LongPeriods_CascadeDownAndFireOnTime)
+{
+    TimerWheel sut;
+    TickRecorder a(sut), b(sut), c(sut);
+    sut.advance(200);
+    sut.add(a, 300);
+    sut.add(b, 65536);
+    sut.add(c, (1u << 24) + 5);
+
+    sut.advance((1u << 24) + 10);
+
+    ASSERT_FALSE(a.ticks.empty());
+    EXPECT_EQ(500u, a.ticks.front());
+    EXPECT_EQ(200u + 300u * a.ticks.size(), a.ticks.back());
+    ASSERT_FALSE(b.ticks.empty());
+    EXPECT_EQ(200u + 65536u, b.ticks.front());
+    EXPECT_EQ((std::vector<std::uint64_t>{200u + (1u << 24) + 5}), c.ticks);
+}
+
+TEST(TimerWheelTest, test_Cancel_StopsTheGame)
+{
+    TimerWheel sut;
+    TickRecorder a(sut), b(sut);
+    auto const timer = sut.add(a, 2);
+    sut.add(b, 2);
+
+    sut.advance(4);
+    sut.cancel(timer);
+    sut.advance(4);
+
+    EXPECT_EQ(2u, a.ticks.size());
+    EXPECT_EQ(4u, b.ticks.size());
+    EXPECT_EQ(1u, sut.size());
+}
+
+TEST(TimerWheelTest, test_GameCancellingItselfWhileFired_IsNotRescheduled)
+{
+    TimerWheel sut;
+    TickRecorder a(sut), b(sut);
+    TimerWheel::TimerId timer = sut.add(a, 5);
+    a.onTick = [&] {
+        sut.cancel(timer);
+        sut.add(b, 1);
+    };
+
+    sut.advance(8);
+
+    EXPECT_EQ((std::vector<std::uint64_t>{5}), a.ticks);
+    EXPECT_EQ((std::vector<std::uint64_t>{6, 7, 8}), b.ticks);
+}
+
+TEST(TimerWheelTest, test_RandomPeriods_MatchEveryPeriodMultiple)
+{
+    TimerWheel sut;
+    std::mt19937 random(3);
+    std::uniform_int_distribution<std::uint64_t> period(1, 2000);
+
+    std::vector<std::unique_ptr<TickRecorder>> games;
+    std::vector<std::uint64_t> periods;
+    for (int i = 0; i < 200; ++i) {
+        games.push_back(std::make_unique<TickRecorder>(sut));
+        periods.push_back(period(random));
+        sut.add(*games.back(), periods.back());
+    }
+
+    sut.advance(70000);
+
+    for (std::size_t i = 0; i < games.size(); ++i) {
+        ASSERT_EQ(70000u / periods[i], games[i]->ticks.size());
+        for (std::size_t n = 0; n < games[i]->ticks.size(); ++n) {
+            ASSERT_EQ((n + 1) * periods[i], games[i]->ticks[n]);
+        }
+    }
+}
+
+TEST(TimerWheelTest, test_BadPeriod_Throws)
+{
+    TimerWheel sut;
+    TickRecorder a(sut);
+
+    EXPECT_THROW(sut.add(a, 0), std::invalid_argument);
+    EXPECT_THROW(sut.add(a, TimerWheel::MAX_PERIOD + 1), std::invalid_argument);
+}
+
+} // namespace Snake
@@ -0,0 +1,142 @@
+#include "TimerWheel.hpp"
+
+#include <stdexcept>
+
+namespace Snake
+{
+namespace
+{
+ControllerChannel::Message const timeout{TimeoutInd{}};
+} // namespace
+
+TimerWheel::TimerId TimerWheel::add(ControllerChannel::IHandler& p_game, std::uint64_t p_period)
+{
+    if (p_period == 0 or p_period > MAX_PERIOD) {
+        throw std::invalid_argument("TimerWheel period must be in [1, 2^32 - 1] ticks");
+    }
+
+    TimerId id;
+    if (m_freeTimers.empty()) {
+        id = static_cast<TimerId>(m_timers.size());
+        m_timers.emplace_back();
+    } else {
+        id = m_freeTimers.back();
+        m_freeTimers.pop_back();
+    }
+
+    m_timers[id] = Timer{&p_game, p_period, m_now + p_period, NONE, NONE, NONE, true};
+    link(id);
+    ++m_active;
+    return id;
+}
+
+void TimerWheel::cancel(TimerId p_timer)
+{
+    auto& timer = m_timers.at(p_timer);
+    if (not timer.active) {
+        return;
+    }
+
+    // A timer being fired is already unlinked.
+    if (timer.slot != NONE) {
+        unlink(p_timer);
+    }
+    timer.active = false;
+    m_freeTimers.push_back(p_timer);
+    --m_active;
+}
+
+std::size_t TimerWheel::advance(std::uint64_t p_ticks)
+{
+    std::size_t fired = 0;
+    for (std::uint64_t i = 0; i < p_ticks; ++i) {
+        ++m_now;
+
+        // Higher levels first, so that their timers can still land in the lower slots cascaded
+        // at the same tick.
+        int top = 0;
+        while (top + 1 < LEVELS and (m_now & ((std::uint64_t{1} << (SLOT_BITS * (top + 1))) - 1)) == 0) {
+            ++top;
+        }
+        for (int level = top; level > 0; --level) {
+            cascade(level);
+        }
+
+        fired += fire();
+    }
+    return fired;
+}
+
+void TimerWheel::link(TimerId p_timer)
+{
+    auto& timer = m_timers[p_timer];
+    auto const delta = timer.expiry - m_now;
+
+    int level = 0;
+    while (level + 1 < LEVELS and delta >= (std::uint64_t{1} << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    auto const slot = static_cast<std::uint32_t>(level) * SLOTS +
+                      static_cast<std::uint32_t>((timer.expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    timer.slot = slot;
+    timer.previous = NONE;
+    timer.next = m_slots[slot];
+    if (timer.next != NONE) {
+        m_timers[timer.next].previous = p_timer;
+    }
+    m_slots[slot] = p_timer;
+}
+
+void TimerWheel::unlink(TimerId p_timer) noexcept
+{
+    auto& timer = m_timers[p_timer];
+    if (timer.previous != NONE) {
+        m_timers[timer.previous].next = timer.next;
+    } else {
+        m_slots[timer.slot] = timer.next;
+    }
+    if (timer.next != NONE) {
+        m_timers[timer.next].previous = timer.previous;
+    }
+    timer.slot = NONE;
+}
+
+void TimerWheel::cascade(int p_level)
+{
+    auto const slot = static_cast<std::uint32_t>(p_level) * SLOTS +
+                      static_cast<std::uint32_t>((m_now >> (SLOT_BITS * p_level)) & (SLOTS - 1));
+
+    auto id = m_slots[slot];
+    m_slots[slot] = NONE;
+    while (id != NONE) {
+        auto const next = m_timers[id].next;
+        link(id);
+        id = next;
+    }
+}
+
+std::size_t TimerWheel::fire()
+{
+    auto const slot = static_cast<std::uint32_t>(m_now & (SLOTS - 1));
+
+    // Every timer here is due now, and goes back into a later slot, so the loop ends.
+    std::size_t fired = 0;
+    while (m_slots[slot] != NONE) {
+        auto const id = m_slots[slot];
+        unlink(id);
+        auto* const game = m_timers[id].game;
+        game->receive(timeout);
+        ++fired;
+
+        // Unless the game cancelled it, or cancelled it and the id went to a new timer.
+        auto& timer = m_timers[id];
+        if (timer.active and timer.slot == NONE) {
+            timer.expiry += timer.period;
+            link(id);
+        }
+    }
+    return fired;
+}
+
+} // namespace Snake
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SnakeChannels.hpp"
+
+namespace Snake
+{
+
+// Drives TimeoutInd into many games, each at its own period, counted in wheel ticks. Four levels
+// of 256 slots hold the timers in intrusive lists: level 0 has the timers due in the next 256
+// ticks, one slot per tick, and each higher level covers 256 times the span of the one below,
+// its slots being moved down as the time comes. Adding and cancelling a timer is O(1), and each
+// tick fires the whole due slot with the one preallocated TimeoutInd message.
+//
+// Not thread-safe. Games fired from advance() may add and cancel timers, their own included.
+class TimerWheel
+{
+public:
+    using TimerId = std::uint32_t;
+
+    static constexpr std::uint64_t MAX_PERIOD = (std::uint64_t{1} << 32) - 1;
+
+    // Fires p_game every p_period ticks from now, p_period in [1, MAX_PERIOD].
+    TimerId add(ControllerChannel::IHandler& p_game, std::uint64_t p_period);
+
+    // Stops the timer; its id may be handed out again by add().
+    void cancel(TimerId p_timer);
+
+    // Moves time on by p_ticks, firing every game due on the way. Returns how many fired.
+    std::size_t advance(std::uint64_t p_ticks = 1);
+
+    std::uint64_t now() const noexcept { return m_now; }
+    std::size_t size() const noexcept { return m_active; }
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int SLOT_BITS = 8;
+    static constexpr std::uint32_t SLOTS = 1u << SLOT_BITS;
+    static constexpr std::uint32_t NONE = 0xFFFFFFFF;
+
+    struct Timer
+    {
+        ControllerChannel::IHandler* game;
+        std::uint64_t period;
+        std::uint64_t expiry;
+        std::uint32_t previous;
+        std::uint32_t next;
+        std::uint32_t slot; // index into m_slots while linked, NONE otherwise
+        bool active;
+    };
+
+    void link(TimerId p_timer);
+    void unlink(TimerId p_timer) noexcept;
+    void cascade(int p_level);
+    std::size_t fire();
+
+    std::vector<Timer> m_timers;
+    std::vector<TimerId> m_freeTimers;
+    std::array<std::uint32_t, LEVELS * SLOTS> m_slots = filledSlots();
+    std::uint64_t m_now = 0;
+    std::size_t m_active = 0;
+
+    static std::array<std::uint32_t, LEVELS * SLOTS> filledSlots() noexcept
+    {
+        std::array<std::uint32_t, LEVELS * SLOTS> slots;
+        slots.fill(NONE);
+        return slots;
+    }
+};
+
+} // namespace Snake
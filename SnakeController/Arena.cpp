@@ -0,0 +1,148 @@
+#include "Arena.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace Snake
+{
+
+Arena::Arena(int p_width, int p_height)
+    : m_width(p_width),
+      m_height(p_height),
+      m_occupancy(p_width, p_height),
+      m_food(p_width, p_height)
+{}
+
+SnakeId Arena::addSnake(std::vector<std::pair<int, int>> const& p_segments, Direction p_direction)
+{
+    if (p_segments.empty()) {
+        throw std::invalid_argument("Snake::Arena: a snake needs at least one segment");
+    }
+    ArenaSnake snake;
+    snake.direction = p_direction;
+    snake.body.reserve(p_segments.size());
+    for (std::size_t i = 0; i < p_segments.size(); ++i) {
+        auto const [x, y] = p_segments[i];
+        char const* error = nullptr;
+        if (not contains(x, y) or m_occupancy.isOccupied(x, y) or m_food.isOccupied(x, y)) {
+            error = "Snake::Arena: segment off the map or on a taken cell";
+        } else if (i > 0 and std::abs(x - p_segments[i - 1].first) + std::abs(y - p_segments[i - 1].second) != 1) {
+            error = "Snake::Arena: segments are not adjacent";
+        }
+        if (error) {
+            for (std::size_t j = 0; j < i; ++j) {
+                m_occupancy.release(p_segments[j].first, p_segments[j].second);
+            }
+            throw std::invalid_argument(error);
+        }
+
+        snake.body.push_back(ArenaSegment{x, y, p_segments.size() - i});
+        m_occupancy.occupy(x, y);
+    }
+
+    m_snakes.push_back(std::move(snake));
+    m_alive.push_back(m_snakes.size() - 1);
+    return m_snakes.size() - 1;
+}
+
+void Arena::setDirection(SnakeId p_snake, Direction p_direction)
+{
+    auto& snake = m_snakes.at(p_snake);
+    if ((snake.direction & 0b01) != (p_direction & 0b01)) {
+        snake.direction = p_direction;
+    }
+}
+
+bool Arena::placeFood(int p_x, int p_y)
+{
+    if (not contains(p_x, p_y) or m_occupancy.isOccupied(p_x, p_y)) {
+        return false;
+    }
+    m_food.occupy(p_x, p_y);
+    return true;
+}
+
+std::vector<ArenaOutcome> const& Arena::tick()
+{
+    m_outcomes.clear();
+    m_displayCells.clear();
+
+    // Aim every head, against the bodies as they are and the heads aimed so far.
+    for (std::size_t i = 0; i < m_alive.size(); ++i) {
+        auto& snake = m_snakes[m_alive[i]];
+        auto const direction = snake.direction;
+        auto const& head = snake.body.front();
+        snake.next.x = head.x + ((direction & 0b01) ? (direction & 0b10) ? 1 : -1 : 0);
+        snake.next.y = head.y + (not (direction & 0b01) ? (direction & 0b10) ? 1 : -1 : 0);
+        snake.next.releaseAt = head.releaseAt;
+
+        auto const x = snake.next.x;
+        auto const y = snake.next.y;
+        auto outcome = Tick_LOST;
+        if (contains(x, y) and not m_occupancy.isOccupied(x, y)) {
+            if (auto const rival = m_claims.get(x, y)) {
+                m_outcomes[rival - 1].outcome = Tick_LOST;
+            } else {
+                m_claims.set(x, y, static_cast<std::uint32_t>(i + 1));
+                outcome = m_food.isOccupied(x, y) ? Tick_ATE : Tick_MOVED;
+            }
+        }
+        m_outcomes.push_back(ArenaOutcome{m_alive[i], outcome});
+    }
+
+    // Free the cells left: whole bodies of the losers, the expired tails of those that moved.
+    for (auto const& result : m_outcomes) {
+        auto& snake = m_snakes[result.snake];
+        if (contains(snake.next.x, snake.next.y)) {
+            m_claims.set(snake.next.x, snake.next.y, 0);
+        }
+
+        if (result.outcome == Tick_LOST) {
+            remove(snake);
+        } else if (result.outcome == Tick_MOVED) {
+            // Only a head that moved outlives the one before it; one that ate leaves with it, as in
+            // Controller::tick().
+            ++snake.next.releaseAt;
+            ++snake.moves;
+            while (not snake.body.empty() and snake.body.back().releaseAt <= snake.moves) {
+                auto const& tail = snake.body.back();
+                m_occupancy.release(tail.x, tail.y);
+                m_displayCells.push_back(DisplayInd{tail.x, tail.y, Cell_FREE});
+                snake.body.pop_back();
+            }
+        }
+    }
+
+    for (auto const& result : m_outcomes) {
+        if (result.outcome == Tick_LOST) {
+            continue;
+        }
+        auto& snake = m_snakes[result.snake];
+        auto const x = snake.next.x;
+        auto const y = snake.next.y;
+        snake.body.push_front(snake.next);
+        m_occupancy.occupy(x, y);
+        if (result.outcome == Tick_ATE) {
+            m_food.release(x, y);
+        }
+        m_displayCells.push_back(DisplayInd{x, y, Cell_SNAKE});
+    }
+
+    m_alive.erase(std::remove_if(m_alive.begin(), m_alive.end(),
+                                 [this](SnakeId p_snake) { return not m_snakes[p_snake].alive; }),
+                  m_alive.end());
+    return m_outcomes;
+}
+
+void Arena::remove(ArenaSnake& p_snake)
+{
+    for (std::size_t i = 0; i < p_snake.body.size(); ++i) {
+        auto const& segment = p_snake.body[i];
+        m_occupancy.release(segment.x, segment.y);
+        m_displayCells.push_back(DisplayInd{segment.x, segment.y, Cell_FREE});
+    }
+    p_snake.alive = false;
+}
+
+} // namespace Snake
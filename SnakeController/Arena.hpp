@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "OccupancyGrid.hpp"
+#include "RingBuffer.hpp"
+#include "SnakeController.hpp"
+#include "SnakeInterface.hpp"
+#include "SparseGrid.hpp"
+
+namespace Snake
+{
+
+using SnakeId = std::size_t;
+
+struct ArenaOutcome
+{
+    SnakeId snake;
+    TickOutcome outcome;
+};
+
+// Many snakes on one map, moved together by tick(). All bodies share one OccupancyGrid and the
+// new heads of a tick are matched through a SparseGrid, so a tick costs O(snakes) whatever their
+// length; only a dying snake pays for its length, once, when its body is cleared off the map.
+//
+// Every snake steps at once. A head loses on leaving the map, on any cell occupied when the tick
+// starts (tails about to move away included, as for a single Controller), or on a cell that
+// another head enters in the same tick, in which case both lose. A snake that lost is removed
+// from the map. Food is eaten by a head entering its cell alone. Growth follows the Controller:
+// the new head leaves the map on the same tick as the head before it, so a snake is one longer
+// until the segments it had when eating have all moved on, and then back to its old length.
+class Arena
+{
+public:
+    Arena(int p_width, int p_height);
+
+    // p_segments go from head to tail, each next to the one before, on free cells of the map.
+    // Throws std::invalid_argument otherwise.
+    SnakeId addSnake(std::vector<std::pair<int, int>> const& p_segments, Direction p_direction);
+
+    // Ignored when reversing the snake onto itself, as with DirectionInd.
+    void setDirection(SnakeId p_snake, Direction p_direction);
+
+    // Returns false, placing nothing, when the cell is off the map or taken by a snake.
+    bool placeFood(int p_x, int p_y);
+
+    // Moves every live snake once. Returns what happened to each of them, in the order they were
+    // added; displayChanges() holds the cells changed, freed ones first.
+    std::vector<ArenaOutcome> const& tick();
+
+    std::vector<DisplayInd> const& displayChanges() const noexcept { return m_displayCells; }
+
+    bool isAlive(SnakeId p_snake) const { return m_snakes.at(p_snake).alive; }
+    std::size_t length(SnakeId p_snake) const { return m_snakes.at(p_snake).body.size(); }
+    std::pair<int, int> head(SnakeId p_snake) const
+    {
+        auto const& segment = m_snakes.at(p_snake).body.front();
+        return std::make_pair(segment.x, segment.y);
+    }
+    std::size_t aliveCount() const noexcept { return m_alive.size(); }
+
+private:
+    struct ArenaSegment
+    {
+        int x;
+        int y;
+        std::uint64_t releaseAt; // value of moves at which the segment leaves the map
+    };
+
+    struct ArenaSnake
+    {
+        RingBuffer<ArenaSegment> body;        // head first
+        std::uint64_t moves = 0;              // ticks moved without eating
+        Direction direction;
+        bool alive = true;
+        ArenaSegment next;                    // head after the tick being made
+    };
+
+    bool contains(int p_x, int p_y) const noexcept
+    {
+        return p_x >= 0 and p_y >= 0 and p_x < m_width and p_y < m_height;
+    }
+
+    void remove(ArenaSnake& p_snake);
+
+    int m_width;
+    int m_height;
+    OccupancyGrid m_occupancy;
+    OccupancyGrid m_food;
+    SparseGrid<std::uint32_t> m_claims; // 1 + index into m_alive of the head entering the cell
+
+    std::vector<ArenaSnake> m_snakes;
+    std::vector<SnakeId> m_alive;
+    std::vector<ArenaOutcome> m_outcomes;
+    std::vector<DisplayInd> m_displayCells;
+};
+
+} // namespace Snake
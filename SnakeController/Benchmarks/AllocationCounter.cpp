@@ -0,0 +1,39 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+std::atomic<std::size_t> allocations{0};
+} // namespace
+
+namespace Snake
+{
+
+std::size_t allocationCount() noexcept
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+} // namespace Snake
+
+void* operator new(std::size_t p_size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(p_size ? p_size : 1)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p_block) noexcept
+{
+    std::free(p_block);
+}
+
+void operator delete(void* p_block, std::size_t) noexcept
+{
+    std::free(p_block);
+}
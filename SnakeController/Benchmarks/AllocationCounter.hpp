@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Snake
+{
+
+// Number of global operator new calls made by the benchmark process so far.
+std::size_t allocationCount() noexcept;
+
+} // namespace Snake
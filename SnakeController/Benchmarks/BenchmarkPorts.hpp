@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include "Event.hpp"
+#include "IPort.hpp"
+#include "TypedChannel.hpp"
+
+namespace Snake
+{
+
+// Swallows every event; keeps gmock bookkeeping out of the measured path.
+class NullPort : public IPort
+{
+public:
+    void send(std::unique_ptr<Event> p_evt) override { benchmark::DoNotOptimize(p_evt.get()); }
+};
+
+// Swallows every typed message.
+template <class Channel>
+class NullChannelPort : public Channel::IPort
+{
+public:
+    void send(typename Channel::Message const& p_message) override { benchmark::DoNotOptimize(&p_message); }
+};
+
+// Counts sent events per MESSAGE_ID.
+class RecordingPort : public IPort
+{
+public:
+    void send(std::unique_ptr<Event> p_evt) override { ++m_counts[p_evt->getMessageId()]; }
+
+    std::size_t count(std::uint32_t p_messageId) const
+    {
+        auto const found = m_counts.find(p_messageId);
+        return found == m_counts.end() ? 0 : found->second;
+    }
+
+private:
+    std::unordered_map<std::uint32_t, std::size_t> m_counts;
+};
+
+} // namespace Snake
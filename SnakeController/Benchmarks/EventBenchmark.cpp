@@ -0,0 +1,234 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "AllocationCounter.hpp"
+#include "BenchmarkPorts.hpp"
+#include "EventRouter.hpp"
+#include "EventT.hpp"
+#include "MpscQueue.hpp"
+#include "SharedEventT.hpp"
+#include "SnakeCodecs.hpp"
+#include "SnakeInterface.hpp"
+#include "WireFrame.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+void reportAllocations(benchmark::State& state, std::size_t p_allocationsBefore)
+{
+    state.counters["allocs/iter"] = benchmark::Counter(
+        static_cast<double>(allocationCount() - p_allocationsBefore),
+        benchmark::Counter::kAvgIterations);
+}
+
+void BM_EventT_Create(benchmark::State& state)
+{
+    DisplayInd displayInd{1, 2, Cell_SNAKE};
+
+    auto const allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        std::unique_ptr<Event> event = std::make_unique<EventT<DisplayInd>>(displayInd);
+        benchmark::DoNotOptimize(event.get());
+    }
+    reportAllocations(state, allocationsBefore);
+}
+BENCHMARK(BM_EventT_Create);
+
+void BM_EventT_Clone(benchmark::State& state)
+{
+    EventT<DisplayInd> displayInd(DisplayInd{1, 2, Cell_SNAKE});
+
+    auto const allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        auto event = displayInd.clone();
+        benchmark::DoNotOptimize(event.get());
+    }
+    reportAllocations(state, allocationsBefore);
+}
+BENCHMARK(BM_EventT_Clone);
+
+// Events created here and destroyed on a consumer thread, as through AsyncEventHandler; their
+// blocks go back to this thread's pool, so allocs/iter should drop to nothing once warm.
+void BM_EventT_CreateHereDestroyThere(benchmark::State& state)
+{
+    MpscQueue<std::unique_ptr<Event>> queue(1024);
+    std::atomic<bool> stop{false};
+    std::thread consumer([&] {
+        std::unique_ptr<Event> event;
+        while (not stop.load(std::memory_order_relaxed) or queue.size()) {
+            while (queue.tryPop(event)) {
+                event.reset();
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    auto const allocationsBefore = allocationCount();
+    int x = 0;
+    for (auto _ : state) {
+        std::unique_ptr<Event> event = std::make_unique<EventT<DisplayInd>>(DisplayInd{x++, 2, Cell_SNAKE});
+        while (not queue.tryPush(event)) {
+            std::this_thread::yield();
+        }
+    }
+    reportAllocations(state, allocationsBefore);
+
+    stop = true;
+    consumer.join();
+}
+BENCHMARK(BM_EventT_CreateHereDestroyThere)->UseRealTime();
+
+// Picks the DisplayInd events out of a mix, checking each cast as a receiver has to.
+std::vector<std::unique_ptr<Event>> mixedEvents()
+{
+    std::vector<std::unique_ptr<Event>> events;
+    for (int i = 0; i < 256; ++i) {
+        switch (i % 3) {
+        case 0: events.push_back(std::make_unique<EventT<DisplayInd>>(DisplayInd{i, i, Cell_SNAKE})); break;
+        case 1: events.push_back(std::make_unique<EventT<TimeoutInd>>()); break;
+        default: events.push_back(std::make_unique<EventT<FoodInd>>(FoodInd{i, i})); break;
+        }
+    }
+    return events;
+}
+
+void BM_EventCast(benchmark::State& state)
+{
+    auto const events = mixedEvents();
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto const& event : events) {
+            if (auto const display = event_cast<DisplayInd>(*event)) {
+                sum += display->get().x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(BM_EventCast);
+
+#ifdef __GXX_RTTI
+void BM_DynamicCast(benchmark::State& state)
+{
+    auto const events = mixedEvents();
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto const& event : events) {
+            if (auto const display = dynamic_cast<PayloadEvent<DisplayInd> const*>(event.get())) {
+                sum += display->get().x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(BM_DynamicCast);
+#endif
+
+// One display batch of range(0) cells cloned to 10k spectators, as the fan-out layer does.
+template <template <class> class EventType>
+void BM_Broadcast_DisplayBatch(benchmark::State& state)
+{
+    constexpr std::size_t subscribers = 10000;
+    std::vector<NullPort> spectators(subscribers);
+    EventType<DisplayBatchInd> const batch(DisplayBatchInd{std::vector<DisplayInd>(state.range(0), DisplayInd{1, 2, Cell_SNAKE})});
+
+    auto const allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        for (auto& spectator : spectators) {
+            spectator.send(batch.clone());
+        }
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetItemsProcessed(state.iterations() * subscribers);
+}
+BENCHMARK_TEMPLATE(BM_Broadcast_DisplayBatch, EventT)->Arg(2)->Arg(64);
+BENCHMARK_TEMPLATE(BM_Broadcast_DisplayBatch, SharedEventT)->Arg(2)->Arg(64);
+
+// A fresh 64-cell display batch per iteration, published to range(0) subscribers through the router.
+void BM_EventRouter_Send(benchmark::State& state)
+{
+    std::vector<NullPort> spectators(state.range(0));
+    EventRouter router;
+    for (auto& spectator : spectators) {
+        router.subscribe(DisplayBatchInd::MESSAGE_ID, spectator);
+    }
+    DisplayBatchInd const batch{std::vector<DisplayInd>(64, DisplayInd{1, 2, Cell_SNAKE})};
+
+    auto const allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        router.send(std::make_unique<EventT<DisplayBatchInd>>(batch));
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventRouter_Send)->Arg(1)->Arg(16)->Arg(10000);
+
+
+EventCodecRegistry snakeCodecs()
+{
+    EventCodecRegistry codecs;
+    registerSnakeCodecs(codecs);
+    return codecs;
+}
+
+// The 256 mixed events above written as wire frames into one buffer, reused between iterations.
+void BM_WireFrame_Encode(benchmark::State& state)
+{
+    auto const codecs = snakeCodecs();
+    auto const events = mixedEvents();
+    std::vector<std::uint8_t> bytes;
+
+    for (auto _ : state) {
+        bytes.clear();
+        for (auto const& event : events) {
+            encodeFrame(codecs, *event, bytes);
+        }
+        benchmark::DoNotOptimize(bytes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * events.size());
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_WireFrame_Encode);
+
+// Reads the same buffer back: range(0) picks views read in place, or an event decoded per frame.
+void BM_WireFrame_Decode(benchmark::State& state)
+{
+    auto const codecs = snakeCodecs();
+    bool const toEvents = state.range(0);
+    std::vector<std::uint8_t> bytes;
+    for (auto const& event : mixedEvents()) {
+        encodeFrame(codecs, *event, bytes);
+    }
+
+    auto const allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        WireFrameReader reader(bytes.data(), bytes.size());
+        WireFrameView frame;
+        int sum = 0;
+        while (reader.next(frame)) {
+            if (toEvents) {
+                auto const event = codecs.decode(frame.messageId, frame.payload, frame.payloadSize);
+                if (auto const display = event_cast<DisplayInd>(*event)) {
+                    sum += display->get().x;
+                }
+            } else if (frame.is<DisplayInd>()) {
+                sum += frame.as<DisplayInd>().x;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    reportAllocations(state, allocationsBefore);
+    state.SetItemsProcessed(state.iterations() * 256);
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_WireFrame_Decode)->Arg(0)->Arg(1);
+
+} // namespace
+} // namespace Snake
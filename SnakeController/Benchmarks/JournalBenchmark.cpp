@@ -0,0 +1,100 @@
+#include <cstdio>
+
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "BenchmarkPorts.hpp"
+#include "EventCodecRegistry.hpp"
+#include "EventJournal.hpp"
+#include "EventT.hpp"
+#include "JournalReplay.hpp"
+#include "SnakeCodecs.hpp"
+#include "SnakeController.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+// A one-segment snake circling a 2x2 square never dies, whatever the number of ticks.
+std::string const circlingConfig = "W 10 10 F 9 9 S R 1 4 4";
+Direction const circle[] = {Direction_RIGHT, Direction_DOWN, Direction_LEFT, Direction_UP};
+
+std::string journalPath()
+{
+    return "/tmp/snake_journal_bench_" + std::to_string(::getpid()) + ".bin";
+}
+
+EventCodecRegistry const& snakeCodecs()
+{
+    static EventCodecRegistry const codecs = [] {
+        EventCodecRegistry codecs;
+        registerSnakeCodecs(codecs);
+        return codecs;
+    }();
+    return codecs;
+}
+
+void recordCirclingGame(std::string const& p_path, int p_ticks)
+{
+    NullPort sink;
+    EventJournal journal(p_path, snakeCodecs());
+    JournalingPort displayPort(journal, 1, sink);
+    JournalingPort foodPort(journal, 2, sink);
+    JournalingPort scorePort(journal, 3, sink);
+    Controller controller(displayPort, foodPort, scorePort, circlingConfig);
+    JournalingEventHandler handler(journal, controller);
+
+    EventT<TimeoutInd> te;
+    for (int tick = 0; tick < p_ticks; ++tick) {
+        handler.receive(std::make_unique<EventT<DirectionInd>>(DirectionInd{circle[tick % 4]}));
+        handler.receive(te.clone());
+    }
+}
+
+void BM_Journal_Record(benchmark::State& state)
+{
+    auto const path = journalPath();
+    {
+        NullPort sink;
+        EventJournal journal(path, snakeCodecs());
+        JournalingPort displayPort(journal, 1, sink);
+        JournalingPort foodPort(journal, 2, sink);
+        JournalingPort scorePort(journal, 3, sink);
+        Controller controller(displayPort, foodPort, scorePort, circlingConfig);
+        JournalingEventHandler handler(journal, controller);
+
+        EventT<TimeoutInd> te;
+        int tick = 0;
+        for (auto _ : state) {
+            handler.receive(std::make_unique<EventT<DirectionInd>>(DirectionInd{circle[tick++ % 4]}));
+            handler.receive(te.clone());
+        }
+        state.SetItemsProcessed(static_cast<std::int64_t>(journal.events()));
+    }
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_Journal_Record)->Iterations(1 << 19);
+
+void BM_Journal_Replay(benchmark::State& state)
+{
+    auto const path = journalPath();
+    recordCirclingGame(path, 1 << 19);
+
+    EventJournalReader reader(path);
+    std::uint64_t mismatches = 0;
+    for (auto _ : state) {
+        JournalReplay replay(reader, snakeCodecs());
+        Controller fresh(replay.port(1), replay.port(2), replay.port(3), circlingConfig);
+        mismatches += replay.run(fresh).mismatches;
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(reader.events()));
+    state.counters["mismatches"] = static_cast<double>(mismatches);
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_Journal_Replay)->Unit(benchmark::kMillisecond);
+
+} // namespace
+} // namespace Snake
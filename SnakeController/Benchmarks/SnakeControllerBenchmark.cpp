@@ -0,0 +1,544 @@
+#include "SnakeController.hpp"
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "AllocationCounter.hpp"
+#include "Arena.hpp"
+#include "BenchmarkPorts.hpp"
+#include "EventT.hpp"
+#include "OccupancyGrid.hpp"
+#include "TickBatch.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+template <class Port = NullPort>
+struct ControllerFixture
+{
+    Port displayPort;
+    Port foodPort;
+    Port scorePort;
+
+    std::string config;
+    std::unique_ptr<Controller> sut;
+
+    explicit ControllerFixture(std::string p_config)
+        : config(std::move(p_config))
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        sut = std::make_unique<Controller>(displayPort, foodPort, scorePort, config);
+    }
+};
+
+// Snake lying along the first row and heading right, with the food off its path.
+std::string rightwardSnakeConfig(int p_length, int p_width)
+{
+    std::string config = "W " + std::to_string(p_width) + " 2 F 0 1 S R " + std::to_string(p_length);
+    for (int x = p_length - 1; x >= 0; --x) {
+        config += " " + std::to_string(x) + " 0";
+    }
+    return config;
+}
+
+constexpr int straightLineRun = 1 << 20;
+std::string const straightLineConfig = rightwardSnakeConfig(1, straightLineRun);
+
+void BM_Receive_TimeoutInd(benchmark::State& state)
+{
+    auto const length = static_cast<int>(state.range(0));
+    ControllerFixture<> fixture(rightwardSnakeConfig(length, length + straightLineRun));
+    EventT<TimeoutInd> te;
+
+    int ticks = 0;
+    for (auto _ : state) {
+        if (++ticks == straightLineRun) {
+            state.PauseTiming();
+            fixture.reset();
+            ticks = 1;
+            state.ResumeTiming();
+        }
+        fixture.sut->receive(te.clone());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Receive_TimeoutInd)->RangeMultiplier(10)->Range(1, 100000);
+
+// Straight-line walk with a snake of ten through the typed channels: no event objects at all.
+void BM_Receive_TimeoutInd_Typed(benchmark::State& state)
+{
+    NullChannelPort<DisplayChannel> displayPort;
+    NullChannelPort<FoodChannel> foodPort;
+    NullChannelPort<ScoreChannel> scorePort;
+    auto const config = rightwardSnakeConfig(10, 10 + straightLineRun);
+    auto sut = std::make_unique<Controller>(displayPort, foodPort, scorePort, config);
+    ControllerChannel::Message const te = TimeoutInd{};
+
+    // The first tick grows the reused display buffer; steady state starts after it.
+    sut->receive(te);
+    int ticks = 1;
+    auto const allocationsBefore = allocationCount();
+    for (auto _ : state) {
+        if (++ticks == straightLineRun) {
+            state.PauseTiming();
+            sut = std::make_unique<Controller>(displayPort, foodPort, scorePort, config);
+            sut->receive(te);
+            ticks = 2;
+            state.ResumeTiming();
+        }
+        sut->receive(te);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs/iter"] = benchmark::Counter(
+        static_cast<double>(allocationCount() - allocationsBefore), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Receive_TimeoutInd_Typed);
+
+// Same straight-line walk with a snake of ten, fast-forwarded 1024 ticks per advance() call.
+void BM_Controller_Advance(benchmark::State& state)
+{
+    ControllerFixture<> fixture(rightwardSnakeConfig(10, 10 + straightLineRun));
+    auto const display = static_cast<AdvanceDisplay>(state.range(0));
+    constexpr int ticksPerCall = 1024;
+
+    int ticks = 0;
+    for (auto _ : state) {
+        if ((ticks += ticksPerCall) >= straightLineRun) {
+            state.PauseTiming();
+            fixture.reset();
+            ticks = ticksPerCall;
+            state.ResumeTiming();
+        }
+        benchmark::DoNotOptimize(fixture.sut->advance(ticksPerCall, display));
+    }
+    state.SetItemsProcessed(state.iterations() * ticksPerCall);
+}
+BENCHMARK(BM_Controller_Advance)->Arg(AdvanceDisplay_NONE)->Arg(AdvanceDisplay_NET);
+
+// Drives a snake clockwise along the map border, turning at the corners, so it never dies.
+class BorderWalk
+{
+public:
+    BorderWalk(int p_width, int p_height, int p_headX)
+        : m_width(p_width), m_height(p_height), m_x(p_headX)
+    {}
+
+    // Direction change needed before the next tick, if any.
+    bool turn(Direction& p_direction)
+    {
+        auto const previous = m_direction;
+        if (m_direction == Direction_RIGHT and m_x == m_width - 1) {
+            m_direction = Direction_DOWN;
+        } else if (m_direction == Direction_DOWN and m_y == m_height - 1) {
+            m_direction = Direction_LEFT;
+        } else if (m_direction == Direction_LEFT and m_x == 0) {
+            m_direction = Direction_UP;
+        } else if (m_direction == Direction_UP and m_y == 0) {
+            m_direction = Direction_RIGHT;
+        }
+        p_direction = m_direction;
+        return previous != m_direction;
+    }
+
+    void step()
+    {
+        m_x += m_direction == Direction_RIGHT ? 1 : m_direction == Direction_LEFT ? -1 : 0;
+        m_y += m_direction == Direction_DOWN ? 1 : m_direction == Direction_UP ? -1 : 0;
+    }
+
+private:
+    int m_width;
+    int m_height;
+    int m_x;
+    int m_y = 0;
+    Direction m_direction = Direction_RIGHT;
+};
+
+// Same straight-line walk as above with a snake of ten, with and without instrumentation attached.
+void BM_Receive_TimeoutInd_Instrumented(benchmark::State& state)
+{
+    ControllerFixture<> fixture(rightwardSnakeConfig(10, 10 + straightLineRun));
+    ControllerInstrumentation instrumentation;
+    bool const instrumented = state.range(0);
+    EventT<TimeoutInd> te;
+
+    int ticks = 0;
+    for (auto _ : state) {
+        if (++ticks == straightLineRun) {
+            state.PauseTiming();
+            fixture.reset();
+            ticks = 1;
+            state.ResumeTiming();
+        }
+        if (ticks == 1) {
+            fixture.sut->setInstrumentation(instrumented ? &instrumentation : nullptr);
+        }
+        fixture.sut->receive(te.clone());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Receive_TimeoutInd_Instrumented)->Arg(0)->Arg(1);
+
+void BM_Receive_TimeoutInd_MapSize(benchmark::State& state)
+{
+    auto const side = static_cast<int>(state.range(0));
+    constexpr int length = 10;
+
+    std::string config = "W " + std::to_string(side) + " " + std::to_string(side) +
+                         " F " + std::to_string(side / 2) + " " + std::to_string(side / 2) +
+                         " S R " + std::to_string(length);
+    for (int x = length - 1; x >= 0; --x) {
+        config += " " + std::to_string(x) + " 0";
+    }
+
+    ControllerFixture<RecordingPort> fixture(config);
+    BorderWalk walk(side, side, length - 1);
+    EventT<TimeoutInd> te;
+    EventT<DirectionInd> turn;
+
+    for (auto _ : state) {
+        if (walk.turn(turn->direction)) {
+            fixture.sut->receive(turn.clone());
+        }
+        fixture.sut->receive(te.clone());
+        walk.step();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["lost"] = static_cast<double>(fixture.scorePort.count(LooseInd::MESSAGE_ID));
+}
+BENCHMARK(BM_Receive_TimeoutInd_MapSize)->RangeMultiplier(4)->Range(16, 16384);
+
+// A queue drained range(0) events at a time: a snake of ten walking the border of a 64 x 64
+// map, turning at the corners. range(1) picks one receive() per event or one receiveBatch().
+void BM_Receive_Batch(benchmark::State& state)
+{
+    auto const batchSize = static_cast<std::size_t>(state.range(0));
+    bool const batched = state.range(1) != 0;
+    constexpr int side = 64;
+    constexpr int length = 10;
+
+    std::string config = "W 64 64 F 32 32 S R " + std::to_string(length);
+    for (int x = length - 1; x >= 0; --x) {
+        config += " " + std::to_string(x) + " 0";
+    }
+    ControllerFixture<> fixture(config);
+    BorderWalk walk(side, side, length - 1);
+    Direction direction = Direction_RIGHT;
+    std::vector<std::unique_ptr<Event>> events;
+    events.reserve(batchSize + 1);
+
+    for (auto _ : state) {
+        events.clear();
+        while (events.size() < batchSize) {
+            if (walk.turn(direction)) {
+                events.push_back(std::make_unique<EventT<DirectionInd>>(DirectionInd{direction}));
+            }
+            events.push_back(std::make_unique<EventT<TimeoutInd>>());
+            walk.step();
+        }
+
+        if (batched) {
+            fixture.sut->receiveBatch(events.data(), events.size());
+        } else {
+            for (auto& event : events) {
+                fixture.sut->receive(std::move(event));
+            }
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batchSize));
+}
+BENCHMARK(BM_Receive_Batch)->ArgsProduct({{1, 4, 16, 64, 256, 1024}, {0, 1}});
+
+void BM_Receive_DirectionInd(benchmark::State& state)
+{
+    ControllerFixture<> fixture(straightLineConfig);
+    EventT<DirectionInd> toUp;
+    EventT<DirectionInd> toRight;
+    toUp->direction = Direction_UP;
+    toRight->direction = Direction_RIGHT;
+
+    bool up = false;
+    for (auto _ : state) {
+        fixture.sut->receive((up = not up) ? toUp.clone() : toRight.clone());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Receive_DirectionInd);
+
+void BM_Receive_FoodInd(benchmark::State& state)
+{
+    ControllerFixture<> fixture(straightLineConfig);
+    EventT<FoodInd> foodInd;
+    foodInd->x = 10;
+    foodInd->y = 1;
+
+    for (auto _ : state) {
+        fixture.sut->receive(foodInd.clone());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Receive_FoodInd);
+
+void BM_Receive_FoodResp(benchmark::State& state)
+{
+    ControllerFixture<> fixture(straightLineConfig);
+    EventT<FoodResp> foodResp;
+    foodResp->x = 10;
+    foodResp->y = 1;
+
+    for (auto _ : state) {
+        fixture.sut->receive(foodResp.clone());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Receive_FoodResp);
+
+void BM_Receive_FoodResp_LongSnake(benchmark::State& state)
+{
+    auto const length = static_cast<int>(state.range(0));
+    ControllerFixture<> fixture(rightwardSnakeConfig(length, length + 1));
+    EventT<FoodResp> foodResp;
+    foodResp->x = 0;
+    foodResp->y = 1;
+
+    for (auto _ : state) {
+        fixture.sut->receive(foodResp.clone());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Receive_FoodResp_LongSnake)->RangeMultiplier(10)->Range(10, 100000);
+
+// Snake winding row by row over the first p_fillPercent of a p_side x p_side map.
+std::string serpentineSnakeConfig(int p_side, int p_fillPercent)
+{
+    auto const length = p_side * p_side / 100 * p_fillPercent;
+    std::string config = "W " + std::to_string(p_side) + " " + std::to_string(p_side) +
+                         " F " + std::to_string(p_side - 1) + " " + std::to_string(p_side - 1) +
+                         " S R " + std::to_string(length);
+    for (int cell = length - 1; cell >= 0; --cell) {
+        auto const y = cell / p_side;
+        auto const x = y % 2 ? p_side - 1 - cell % p_side : cell % p_side;
+        config += " " + std::to_string(x) + " " + std::to_string(y);
+    }
+    return config;
+}
+
+// Food offered on the snake at 99% fill, answered the protocol way: FoodReq, then FoodResp at a
+// uniformly random cell until one is free.
+void BM_FoodPlacement_Requested(benchmark::State& state)
+{
+    auto const side = static_cast<int>(state.range(0));
+    ControllerFixture<RecordingPort> fixture(serpentineSnakeConfig(side, 99));
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> coordinate(0, side - 1);
+
+    std::size_t roundTrips = 0;
+    for (auto _ : state) {
+        auto requests = fixture.foodPort.count(FoodReq::MESSAGE_ID);
+        fixture.sut->receive(std::make_unique<EventT<FoodInd>>(FoodInd{0, 0}));
+        while (fixture.foodPort.count(FoodReq::MESSAGE_ID) != requests) {
+            requests = fixture.foodPort.count(FoodReq::MESSAGE_ID);
+            ++roundTrips;
+            fixture.sut->receive(std::make_unique<EventT<FoodResp>>(FoodResp{coordinate(random), coordinate(random)}));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["round_trips"] = benchmark::Counter(static_cast<double>(roundTrips), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_FoodPlacement_Requested)->Arg(100)->Arg(1000);
+
+// Same offers with in-controller placement: one step, no FoodReq.
+void BM_FoodPlacement_Local(benchmark::State& state)
+{
+    auto const side = static_cast<int>(state.range(0));
+    ControllerFixture<RecordingPort> fixture(serpentineSnakeConfig(side, 99));
+    fixture.sut->enableFoodPlacement(1);
+
+    for (auto _ : state) {
+        fixture.sut->receive(std::make_unique<EventT<FoodInd>>(FoodInd{0, 0}));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["round_trips"] = static_cast<double>(fixture.foodPort.count(FoodReq::MESSAGE_ID));
+}
+BENCHMARK(BM_FoodPlacement_Local)->Arg(100)->Arg(1000);
+
+void BM_Controller_ParseConfig(benchmark::State& state)
+{
+    auto const length = static_cast<int>(state.range(0));
+    auto const config = rightwardSnakeConfig(length, length + 1);
+    NullPort displayPort, foodPort, scorePort;
+
+    for (auto _ : state) {
+        Controller sut(displayPort, foodPort, scorePort, config);
+        benchmark::DoNotOptimize(&sut);
+    }
+
+    state.SetItemsProcessed(state.iterations() * length);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(config.size()));
+    state.counters["games/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Controller_ParseConfig)->RangeMultiplier(10)->Range(10, 100000);
+
+void BM_Controller_RestoreSnapshot(benchmark::State& state)
+{
+    auto const length = static_cast<int>(state.range(0));
+    NullPort displayPort, foodPort, scorePort;
+    auto const snapshot = Controller(displayPort, foodPort, scorePort, rightwardSnakeConfig(length, length + 1)).saveSnapshot();
+
+    for (auto _ : state) {
+        Controller sut(displayPort, foodPort, scorePort, SnapshotView{snapshot.data(), snapshot.size()});
+        benchmark::DoNotOptimize(&sut);
+    }
+
+    state.SetItemsProcessed(state.iterations() * length);
+    state.counters["games/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Controller_RestoreSnapshot)->RangeMultiplier(10)->Range(10, 100000);
+
+void BM_OccupancyGrid_Lookup(benchmark::State& state)
+{
+    auto const side = static_cast<int>(state.range(0));
+    OccupancyGrid grid(side, side);
+    grid.occupy(side / 2, side / 2);
+
+    int x = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(grid.isOccupied(x, side / 2));
+        x = (x + 1) % side;
+    }
+    state.counters["bytes"] = static_cast<double>(grid.memoryUsage());
+}
+BENCHMARK(BM_OccupancyGrid_Lookup)->RangeMultiplier(4)->Range(16, 16384);
+
+void BM_SparseGrid_Lookup(benchmark::State& state)
+{
+    auto const side = state.range(0) - 1;
+    OccupancyGrid grid(static_cast<int>(side), static_cast<int>(side));
+    int const y = static_cast<int>(side / 2);
+    int const x0 = static_cast<int>(side / 2 - 512);
+    for (int x = x0; x < x0 + 1024; x += 2) {
+        grid.occupy(x, y);
+    }
+
+    int x = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(grid.isOccupied(x0 + x, y));
+        x = (x + 1) & 1023;
+    }
+    state.counters["sparse"] = grid.isSparse();
+    state.counters["bytes"] = static_cast<double>(grid.memoryUsage());
+}
+BENCHMARK(BM_SparseGrid_Lookup)->RangeMultiplier(1 << 7)->Range(1 << 10, std::int64_t(1) << 31);
+
+// Each snake circles its own two-row strip of a shared arena, so none of them ever dies:
+// right along the upper row, down, left along the lower row, up, and so on.
+Arena stripArena(int p_snakes, int p_length)
+{
+    Arena arena(2 * p_length, 2 * p_snakes);
+    for (int snake = 0; snake < p_snakes; ++snake) {
+        std::vector<std::pair<int, int>> segments;
+        for (int x = p_length - 1; x >= 0; --x) {
+            segments.emplace_back(x, 2 * snake);
+        }
+        arena.addSnake(segments, Direction_RIGHT);
+    }
+    return arena;
+}
+
+void BM_Arena_Tick(benchmark::State& state)
+{
+    auto const snakes = static_cast<int>(state.range(0));
+    auto const length = static_cast<int>(state.range(1));
+    auto arena = stripArena(snakes, length);
+
+    for (auto _ : state) {
+        for (SnakeId snake = 0; snake < static_cast<SnakeId>(snakes); ++snake) {
+            auto const [x, y] = arena.head(snake);
+            arena.setDirection(snake, y % 2 == 0 ? x == 2 * length - 1 ? Direction_DOWN : Direction_RIGHT
+                                                 : x == 0 ? Direction_UP : Direction_LEFT);
+        }
+        benchmark::DoNotOptimize(arena.tick().data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * snakes);
+    state.counters["alive"] = static_cast<double>(arena.aliveCount());
+}
+BENCHMARK(BM_Arena_Tick)->ArgsProduct({{16, 256}, {10, 1000, 10000}});
+
+
+// range(1) games, each a snake of ten walking the border of its own 16 x 16 map, all ticked once
+// per iteration: range(0) picks Controllers through advance(1), or a TickBatch with the scalar
+// or the AVX2 kernel.
+void BM_TickBatch_Tick(benchmark::State& state)
+{
+    auto const kernel = state.range(0);
+    auto const games = static_cast<std::size_t>(state.range(1));
+    constexpr int side = 16;
+    constexpr int length = 10;
+
+    std::string config = "W 16 16 F 8 8 S R " + std::to_string(length);
+    for (int x = length - 1; x >= 0; --x) {
+        config += " " + std::to_string(x) + " 0";
+    }
+
+    NullChannelPort<DisplayChannel> displayPort;
+    NullChannelPort<FoodChannel> foodPort;
+    NullChannelPort<ScoreChannel> scorePort;
+    std::vector<std::unique_ptr<Controller>> controllers;
+    TickBatch batch(kernel == 1 ? TickKernel_SCALAR : TickKernel_AUTO);
+    if (kernel == 2 and not batch.usesAvx2()) {
+        state.SkipWithError("no AVX2 on this CPU");
+        return;
+    }
+    auto const snapshot = Controller(displayPort, foodPort, scorePort, config).saveSnapshot();
+    for (std::size_t i = 0; i < games; ++i) {
+        if (kernel == 0) {
+            controllers.push_back(std::make_unique<Controller>(displayPort, foodPort, scorePort, config));
+        } else {
+            batch.addGame(SnapshotView{snapshot.data(), snapshot.size()});
+        }
+    }
+
+    BorderWalk walk(side, side, length - 1);
+    ControllerChannel::Message turn = DirectionInd{Direction_RIGHT};
+    std::size_t lost = 0;
+    for (auto _ : state) {
+        Direction direction;
+        if (walk.turn(direction)) {
+            turn = DirectionInd{direction};
+            for (std::size_t i = 0; i < games; ++i) {
+                if (kernel == 0) {
+                    controllers[i]->receive(turn);
+                } else {
+                    batch.setDirection(i, direction);
+                }
+            }
+        }
+        if (kernel == 0) {
+            for (auto& controller : controllers) {
+                lost += controller->advance(1).outcome == Tick_LOST;
+            }
+        } else {
+            for (auto const outcome : batch.tick()) {
+                lost += outcome == Tick_LOST;
+            }
+        }
+        walk.step();
+    }
+
+    state.SetItemsProcessed(state.iterations() * games);
+    state.counters["lost"] = static_cast<double>(lost);
+}
+BENCHMARK(BM_TickBatch_Tick)->ArgsProduct({{0, 1, 2}, {1000, 100000}});
+
+} // namespace
+} // namespace Snake
@@ -0,0 +1,117 @@
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include "EventCodecRegistry.hpp"
+#include "EventT.hpp"
+#include "SharedMemoryRing.hpp"
+#include "SnakeCodecs.hpp"
+#include "SnakeInterface.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+EventCodecRegistry const& transportCodecs()
+{
+    static EventCodecRegistry const codecs = [] {
+        EventCodecRegistry codecs;
+        registerSnakeCodecs(codecs);
+        return codecs;
+    }();
+    return codecs;
+}
+
+// DisplayInd events to a renderer thread reading them in place from a shared memory ring.
+void BM_Transport_SharedMemory(benchmark::State& state)
+{
+    auto ring = SharedMemoryRing::create("/snake_transport_bench_" + std::to_string(::getpid()), 1 << 16);
+    SharedMemoryPort port(ring, transportCodecs());
+    std::atomic<bool> stop{false};
+    std::int64_t painted = 0;
+
+    std::thread renderer([&] {
+        while (not stop.load(std::memory_order_relaxed) or not ring.empty()) {
+            ring.waitForData(std::chrono::milliseconds(1));
+            ring.consume([&](std::uint32_t, std::uint8_t const* p_payload, std::size_t) {
+                DisplayInd cell;
+                std::memcpy(&cell, p_payload, sizeof(cell));
+                painted += cell.value;
+            });
+        }
+    });
+
+    int x = 0;
+    for (auto _ : state) {
+        port.send(std::make_unique<EventT<DisplayInd>>(DisplayInd{x++, 0, Cell_SNAKE}));
+    }
+    stop = true;
+    renderer.join();
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["wakeups"] = static_cast<double>(ring.wakeups());
+}
+BENCHMARK(BM_Transport_SharedMemory)->UseRealTime();
+
+// The same through a socket, one encode and write() per DisplayInd, as a baseline.
+void BM_Transport_Socket(benchmark::State& state)
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        state.SkipWithError("socketpair failed");
+        return;
+    }
+
+    constexpr std::size_t frameSize = sizeof(std::uint32_t) + sizeof(DisplayInd);
+    std::thread renderer([&] {
+        std::uint8_t frames[frameSize * 256];
+        std::size_t buffered = 0;
+        for (;;) {
+            auto const got = ::read(fds[1], frames + buffered, sizeof(frames) - buffered);
+            if (got <= 0) {
+                return;
+            }
+            buffered += static_cast<std::size_t>(got);
+            auto const complete = buffered / frameSize * frameSize;
+            for (std::size_t offset = 0; offset < complete; offset += frameSize) {
+                std::uint32_t messageId;
+                std::memcpy(&messageId, frames + offset, sizeof(messageId));
+                benchmark::DoNotOptimize(transportCodecs().decode(messageId, frames + offset + sizeof(messageId),
+                                                                  sizeof(DisplayInd)));
+            }
+            std::memmove(frames, frames + complete, buffered - complete);
+            buffered -= complete;
+        }
+    });
+
+    std::vector<std::uint8_t> bytes;
+    int x = 0;
+    for (auto _ : state) {
+        EventT<DisplayInd> event(DisplayInd{x++, 0, Cell_SNAKE});
+        transportCodecs().encode(event, bytes);
+        std::uint8_t frame[frameSize];
+        std::uint32_t const messageId = DisplayInd::MESSAGE_ID;
+        std::memcpy(frame, &messageId, sizeof(messageId));
+        std::memcpy(frame + sizeof(messageId), bytes.data(), bytes.size());
+        if (::write(fds[0], frame, sizeof(frame)) != static_cast<ssize_t>(sizeof(frame))) {
+            state.SkipWithError("write failed");
+            break;
+        }
+    }
+    ::close(fds[0]);
+    renderer.join();
+    ::close(fds[1]);
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Transport_Socket)->UseRealTime();
+
+} // namespace
+} // namespace Snake
@@ -0,0 +1,157 @@
+#include "ControllerInstrumentation.hpp"
+
+#include <sstream>
+
+#include "Event.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+char const* const branchNames[] = {"timeout", "direction", "food_ind", "food_resp"};
+char const* const portNames[] = {"display", "food", "score"};
+
+void bump(std::atomic<std::uint64_t>& p_counter) noexcept
+{
+    p_counter.store(p_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void writeHistogram(std::ostream& p_out, LatencyHistogram const& p_histogram, bool p_json)
+{
+    auto const count = p_histogram.count();
+    auto const mean = count ? p_histogram.sum() / count : 0;
+
+    if (p_json) {
+        p_out << "{\"count\": " << count << ", \"mean\": " << mean
+              << ", \"p50\": " << p_histogram.percentile(50) << ", \"p90\": " << p_histogram.percentile(90)
+              << ", \"p99\": " << p_histogram.percentile(99) << ", \"max\": " << p_histogram.max() << "}";
+    } else {
+        p_out << "count=" << count << " mean=" << mean
+              << " p50=" << p_histogram.percentile(50) << " p90=" << p_histogram.percentile(90)
+              << " p99=" << p_histogram.percentile(99) << " max=" << p_histogram.max();
+    }
+}
+
+} // namespace
+
+void ControllerInstrumentation::countMessage(std::uint32_t p_messageId) noexcept
+{
+    auto& stats = m_stats.local();
+    bump(p_messageId < TRACKED_MESSAGE_IDS ? stats.messages[p_messageId] : stats.otherMessages);
+}
+
+void ControllerInstrumentation::recordLatency(Branch p_branch, std::uint64_t p_nanos) noexcept
+{
+    m_stats.local().latency[p_branch].record(p_nanos);
+}
+
+void ControllerInstrumentation::countSent(PortId p_port) noexcept
+{
+    bump(m_stats.local().sent[p_port]);
+}
+
+void ControllerInstrumentation::recordSnakeLength(std::size_t p_length) noexcept
+{
+    m_stats.local().snakeLength.record(p_length);
+}
+
+std::unique_ptr<ControllerInstrumentation::Totals> ControllerInstrumentation::totals() const
+{
+    auto totals = std::make_unique<Totals>();
+    m_stats.forEach([&totals](ThreadStats const& p_stats) {
+        for (std::size_t id = 0; id < TRACKED_MESSAGE_IDS; ++id) {
+            totals->messages[id] += p_stats.messages[id].load(std::memory_order_relaxed);
+        }
+        totals->otherMessages += p_stats.otherMessages.load(std::memory_order_relaxed);
+        for (std::size_t branch = 0; branch < Branch_COUNT; ++branch) {
+            totals->latency[branch].merge(p_stats.latency[branch]);
+        }
+        for (std::size_t port = 0; port < Port_COUNT; ++port) {
+            totals->sent[port] += p_stats.sent[port].load(std::memory_order_relaxed);
+        }
+        totals->snakeLength.merge(p_stats.snakeLength);
+    });
+    return totals;
+}
+
+std::string ControllerInstrumentation::dumpText() const
+{
+    auto const totals = this->totals();
+    std::ostringstream out;
+
+    out << "messages:\n";
+    for (std::size_t id = 0; id < TRACKED_MESSAGE_IDS; ++id) {
+        if (totals->messages[id]) {
+            out << "  0x" << std::hex << id << std::dec << ": " << totals->messages[id] << "\n";
+        }
+    }
+    if (totals->otherMessages) {
+        out << "  other: " << totals->otherMessages << "\n";
+    }
+
+    out << "latency_ns:\n";
+    for (std::size_t branch = 0; branch < Branch_COUNT; ++branch) {
+        out << "  " << branchNames[branch] << ": ";
+        writeHistogram(out, totals->latency[branch], false);
+        out << "\n";
+    }
+
+    out << "sent:\n";
+    for (std::size_t port = 0; port < Port_COUNT; ++port) {
+        out << "  " << portNames[port] << ": " << totals->sent[port] << "\n";
+    }
+
+    out << "snake_length: ";
+    writeHistogram(out, totals->snakeLength, false);
+    out << "\n";
+    return out.str();
+}
+
+std::string ControllerInstrumentation::dumpJson() const
+{
+    auto const totals = this->totals();
+    std::ostringstream out;
+
+    out << "{\"messages\": {";
+    char const* separator = "";
+    for (std::size_t id = 0; id < TRACKED_MESSAGE_IDS; ++id) {
+        if (totals->messages[id]) {
+            out << separator << "\"" << id << "\": " << totals->messages[id];
+            separator = ", ";
+        }
+    }
+    out << "}, \"other_messages\": " << totals->otherMessages;
+
+    out << ", \"latency_ns\": {";
+    for (std::size_t branch = 0; branch < Branch_COUNT; ++branch) {
+        out << (branch ? ", " : "") << "\"" << branchNames[branch] << "\": ";
+        writeHistogram(out, totals->latency[branch], true);
+    }
+
+    out << "}, \"sent\": {";
+    for (std::size_t port = 0; port < Port_COUNT; ++port) {
+        out << (port ? ", " : "") << "\"" << portNames[port] << "\": " << totals->sent[port];
+    }
+
+    out << "}, \"snake_length\": ";
+    writeHistogram(out, totals->snakeLength, true);
+    out << "}";
+    return out.str();
+}
+
+InstrumentedPort::InstrumentedPort(ControllerInstrumentation& p_instrumentation,
+                                   ControllerInstrumentation::PortId p_id,
+                                   IPort& p_port)
+    : m_instrumentation(p_instrumentation),
+      m_id(p_id),
+      m_port(p_port)
+{}
+
+void InstrumentedPort::send(std::unique_ptr<Event> p_event)
+{
+    m_instrumentation.countSent(m_id);
+    m_port.send(std::move(p_event));
+}
+
+} // namespace Snake
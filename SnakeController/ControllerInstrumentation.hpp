@@ -0,0 +1,88 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "IPort.hpp"
+#include "LatencyHistogram.hpp"
+#include "PerThread.hpp"
+
+namespace Snake
+{
+
+// Optional hot-path statistics for any number of controllers. Attach it with
+// Controller::setInstrumentation() and wrap ports in InstrumentedPort to count what they send.
+// Each thread writes to its own cache-line aligned block; dumps fold the blocks together.
+class ControllerInstrumentation
+{
+public:
+    enum Branch
+    {
+        Branch_TIMEOUT,
+        Branch_DIRECTION,
+        Branch_FOOD_IND,
+        Branch_FOOD_RESP,
+        Branch_COUNT
+    };
+
+    enum PortId
+    {
+        Port_DISPLAY,
+        Port_FOOD,
+        Port_SCORE,
+        Port_COUNT
+    };
+
+    // Messages are counted individually for MESSAGE_ID below this value, and together above it.
+    static constexpr std::size_t TRACKED_MESSAGE_IDS = 256;
+
+    void countMessage(std::uint32_t p_messageId) noexcept;
+    void recordLatency(Branch p_branch, std::uint64_t p_nanos) noexcept;
+    void countSent(PortId p_port) noexcept;
+    void recordSnakeLength(std::size_t p_length) noexcept;
+
+    std::string dumpText() const;
+    std::string dumpJson() const;
+
+    struct Totals
+    {
+        std::array<std::uint64_t, TRACKED_MESSAGE_IDS> messages{};
+        std::uint64_t otherMessages = 0;
+        std::array<LatencyHistogram, Branch_COUNT> latency;
+        std::array<std::uint64_t, Port_COUNT> sent{};
+        LatencyHistogram snakeLength;
+    };
+
+    std::unique_ptr<Totals> totals() const;
+
+private:
+    struct ThreadStats
+    {
+        std::array<std::atomic<std::uint64_t>, TRACKED_MESSAGE_IDS> messages{};
+        std::atomic<std::uint64_t> otherMessages{0};
+        std::array<LatencyHistogram, Branch_COUNT> latency;
+        std::array<std::atomic<std::uint64_t>, Port_COUNT> sent{};
+        LatencyHistogram snakeLength;
+    };
+
+    PerThread<ThreadStats> m_stats;
+};
+
+class InstrumentedPort : public IPort
+{
+public:
+    InstrumentedPort(ControllerInstrumentation& p_instrumentation, ControllerInstrumentation::PortId p_id, IPort& p_port);
+
+    void send(std::unique_ptr<Event> p_event) override;
+
+private:
+    ControllerInstrumentation& m_instrumentation;
+    ControllerInstrumentation::PortId const m_id;
+    IPort& m_port;
+};
+
+} // namespace Snake
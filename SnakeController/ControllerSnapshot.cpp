@@ -0,0 +1,127 @@
+#include "SnakeController.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+namespace Snake
+{
+
+SnapshotHeader readSnapshotHeader(SnapshotView p_snapshot)
+{
+    if (p_snapshot.size < sizeof(SnapshotHeader)) {
+        throw ConfigurationError(p_snapshot.size, "truncated snapshot header");
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, p_snapshot.data, sizeof(header));
+
+    if (std::memcmp(header.magic, SnapshotHeader::MAGIC, sizeof(header.magic)) != 0) {
+        throw ConfigurationError(offsetof(SnapshotHeader, magic), "not a controller snapshot");
+    }
+    if (header.version != SnapshotHeader::VERSION) {
+        throw ConfigurationError(offsetof(SnapshotHeader, version), "unsupported snapshot version");
+    }
+    if (header.width <= 0 or header.height <= 0) {
+        throw ConfigurationError(offsetof(SnapshotHeader, width), "map dimensions must be positive");
+    }
+    if (header.direction > Direction_RIGHT) {
+        throw ConfigurationError(offsetof(SnapshotHeader, direction), "invalid snake direction");
+    }
+    if (header.segmentCount == 0) {
+        throw ConfigurationError(offsetof(SnapshotHeader, segmentCount), "snake length must be positive");
+    }
+    if (header.segmentCount > (p_snapshot.size - sizeof(SnapshotHeader)) / sizeof(SnapshotSegment)) {
+        throw ConfigurationError(p_snapshot.size, "truncated snapshot segments");
+    }
+    return header;
+}
+
+void occupySnapshotSegments(SnapshotView p_snapshot, SnapshotHeader const& p_header, OccupancyGrid& p_occupancy)
+{
+    auto const bytes = static_cast<char const*>(p_snapshot.data) + sizeof(SnapshotHeader);
+
+    SnapshotSegment previous{};
+    for (std::size_t i = 0; i < p_header.segmentCount; ++i) {
+        auto const offset = sizeof(SnapshotHeader) + i * sizeof(SnapshotSegment);
+        SnapshotSegment segment;
+        std::memcpy(&segment, bytes + i * sizeof(SnapshotSegment), sizeof(segment));
+
+        if (segment.x < 0 or segment.y < 0 or segment.x >= p_header.width or segment.y >= p_header.height) {
+            throw ConfigurationError(offset, "segment outside the map");
+        }
+        if (p_occupancy.isOccupied(segment.x, segment.y)) {
+            throw ConfigurationError(offset, "segment on a cell the snake already takes");
+        }
+        if (i > 0 and std::abs(segment.x - previous.x) + std::abs(segment.y - previous.y) != 1) {
+            throw ConfigurationError(offset, "segment not adjacent to the previous one");
+        }
+        if (i > 0 and segment.releaseAt > previous.releaseAt) {
+            throw ConfigurationError(offset + offsetof(SnapshotSegment, releaseAt),
+                                     "segment released after the one before it");
+        }
+
+        p_occupancy.occupy(segment.x, segment.y);
+        previous = segment;
+    }
+}
+
+Controller::Controller(std::unique_ptr<Output> p_output, SnapshotView p_snapshot)
+    : m_output(std::move(p_output))
+{
+    static_assert(sizeof(Segment) == sizeof(SnapshotSegment) and
+                  offsetof(Segment, x) == offsetof(SnapshotSegment, x) and
+                  offsetof(Segment, y) == offsetof(SnapshotSegment, y) and
+                  offsetof(Segment, releaseAt) == offsetof(SnapshotSegment, releaseAt),
+                  "Snapshot segments are copied straight into the segment ring");
+
+    auto const bytes = static_cast<char const*>(p_snapshot.data);
+    auto const header = readSnapshotHeader(p_snapshot);
+
+    m_mapDimension = std::make_pair(header.width, header.height);
+    m_foodPosition = std::make_pair(header.foodX, header.foodY);
+    m_currentDirection = static_cast<Direction>(header.direction);
+    m_moves = header.moves;
+    m_occupancy = OccupancyGrid(header.width, header.height);
+
+    auto const count = static_cast<std::size_t>(header.segmentCount);
+    Segment* segments = m_segments.assign(count);
+    std::memcpy(segments, bytes + sizeof(SnapshotHeader), count * sizeof(Segment));
+
+    occupySnapshotSegments(p_snapshot, header, m_occupancy);
+}
+
+std::size_t Controller::snapshotSize() const noexcept
+{
+    return sizeof(SnapshotHeader) + m_segments.size() * sizeof(SnapshotSegment);
+}
+
+void Controller::saveSnapshot(void* p_buffer) const
+{
+    SnapshotHeader header;
+    std::memcpy(header.magic, SnapshotHeader::MAGIC, sizeof(header.magic));
+    header.version = SnapshotHeader::VERSION;
+    header.width = m_mapDimension.first;
+    header.height = m_mapDimension.second;
+    header.foodX = m_foodPosition.first;
+    header.foodY = m_foodPosition.second;
+    header.direction = m_currentDirection;
+    header.reserved = 0;
+    header.moves = m_moves;
+    header.segmentCount = m_segments.size();
+
+    auto const bytes = static_cast<char*>(p_buffer);
+    std::memcpy(bytes, &header, sizeof(header));
+    for (std::size_t i = 0; i < m_segments.size(); ++i) {
+        std::memcpy(bytes + sizeof(SnapshotHeader) + i * sizeof(Segment), &m_segments[i], sizeof(Segment));
+    }
+}
+
+std::vector<std::uint8_t> Controller::saveSnapshot() const
+{
+    std::vector<std::uint8_t> snapshot(snapshotSize());
+    saveSnapshot(snapshot.data());
+    return snapshot;
+}
+
+} // namespace Snake
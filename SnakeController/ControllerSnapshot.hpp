@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Snake
+{
+
+// Binary snapshot of a Snake::Controller, in host byte order:
+//   SnapshotHeader, then segmentCount SnapshotSegment records ordered from head to tail.
+// Records are laid out like the controller's own segments, so restoring copies them in one go.
+struct SnapshotHeader
+{
+    static constexpr char MAGIC[4] = {'S', 'N', 'K', 'S'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    char magic[4];
+    std::uint32_t version;
+    std::int32_t width;
+    std::int32_t height;
+    std::int32_t foodX;
+    std::int32_t foodY;
+    std::uint32_t direction;
+    std::uint32_t reserved;
+    std::uint64_t moves;
+    std::uint64_t segmentCount;
+};
+
+struct SnapshotSegment
+{
+    std::int32_t x;
+    std::int32_t y;
+    std::uint64_t releaseAt; // move count at which the segment leaves the board
+};
+
+static_assert(sizeof(SnapshotHeader) == 48, "Snapshot header layout must not change within a version");
+static_assert(sizeof(SnapshotSegment) == 16, "Snapshot segment layout must not change within a version");
+
+// Non-owning view over snapshot bytes, e.g. a memory-mapped file.
+struct SnapshotView
+{
+    void const* data;
+    std::size_t size;
+};
+
+} // namespace Snake
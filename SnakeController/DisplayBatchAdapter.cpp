@@ -0,0 +1,26 @@
+#include "DisplayBatchAdapter.hpp"
+
+#include "EventT.hpp"
+#include "SnakeInterface.hpp"
+
+namespace Snake
+{
+
+DisplayBatchAdapter::DisplayBatchAdapter(IPort& p_displayPort)
+    : m_displayPort(p_displayPort)
+{}
+
+void DisplayBatchAdapter::send(std::unique_ptr<Event> p_evt)
+{
+    if (p_evt->getMessageId() != DisplayBatchInd::MESSAGE_ID) {
+        m_displayPort.send(std::move(p_evt));
+        return;
+    }
+
+    Event const& batch = *p_evt;
+    for (auto const& cell : payload<DisplayBatchInd>(batch).cells) {
+        m_displayPort.send(std::make_unique<EventT<DisplayInd>>(cell));
+    }
+}
+
+} // namespace Snake
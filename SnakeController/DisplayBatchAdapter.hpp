@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+
+#include "IPort.hpp"
+
+class Event;
+
+namespace Snake
+{
+
+// Display port for consumers that only understand DisplayInd: expands each DisplayBatchInd into
+// one DisplayInd per cell, in batch order, and forwards every other event unchanged.
+class DisplayBatchAdapter : public IPort
+{
+public:
+    explicit DisplayBatchAdapter(IPort& p_displayPort);
+
+    void send(std::unique_ptr<Event> p_evt) override;
+
+private:
+    IPort& m_displayPort;
+};
+
+} // namespace Snake
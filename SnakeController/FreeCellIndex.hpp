@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "OccupancyGrid.hpp"
+
+namespace Snake
+{
+
+// Every free cell of the map in a dense array, plus each cell's position in that array, so a
+// uniformly random free cell is one lookup and occupying or releasing a cell is a swap-remove
+// or an append. Costs eight bytes per cell, which is why the controller only builds it on request,
+// and only for maps small enough to be stored densely: larger ones are refused with length_error.
+class FreeCellIndex
+{
+public:
+    FreeCellIndex(int p_width, int p_height, OccupancyGrid const& p_occupancy)
+        : m_width(p_width),
+          m_height(p_height)
+    {
+        auto const cells = static_cast<std::size_t>(p_width) * static_cast<std::size_t>(p_height);
+        if (cells > OccupancyGrid::DENSE_CELL_LIMIT) {
+            throw std::length_error("Map too large for a free cell index; only maps stored densely have one");
+        }
+
+        m_free.reserve(cells);
+        m_slots.resize(cells, NOT_FREE);
+        for (int y = 0; y < p_height; ++y) {
+            for (int x = 0; x < p_width; ++x) {
+                if (not p_occupancy.isOccupied(x, y)) {
+                    release(x, y);
+                }
+            }
+        }
+    }
+
+    std::size_t size() const noexcept { return m_free.size(); }
+
+    // The p_index-th free cell, for p_index below size(); the order changes as cells come and go.
+    std::pair<int, int> at(std::size_t p_index) const noexcept
+    {
+        auto const cell = m_free[p_index];
+        return std::make_pair(static_cast<int>(cell % static_cast<std::uint32_t>(m_width)),
+                              static_cast<int>(cell / static_cast<std::uint32_t>(m_width)));
+    }
+
+    void occupy(int p_x, int p_y) noexcept
+    {
+        if (not contains(p_x, p_y)) {
+            return;
+        }
+
+        auto const cell = index(p_x, p_y);
+        auto const slot = m_slots[cell];
+        if (slot == NOT_FREE) {
+            return;
+        }
+
+        auto const last = m_free.back();
+        m_free[slot] = last;
+        m_slots[last] = slot;
+        m_free.pop_back();
+        m_slots[cell] = NOT_FREE;
+    }
+
+    void release(int p_x, int p_y) noexcept
+    {
+        if (not contains(p_x, p_y)) {
+            return;
+        }
+
+        auto const cell = index(p_x, p_y);
+        if (m_slots[cell] == NOT_FREE) {
+            m_slots[cell] = static_cast<std::uint32_t>(m_free.size());
+            m_free.push_back(cell);
+        }
+    }
+
+private:
+    static constexpr std::uint32_t NOT_FREE = std::numeric_limits<std::uint32_t>::max();
+
+    bool contains(int p_x, int p_y) const noexcept
+    {
+        return p_x >= 0 and p_y >= 0 and p_x < m_width and p_y < m_height;
+    }
+
+    std::uint32_t index(int p_x, int p_y) const noexcept
+    {
+        return static_cast<std::uint32_t>(p_y) * static_cast<std::uint32_t>(m_width) + static_cast<std::uint32_t>(p_x);
+    }
+
+    int m_width;
+    int m_height;
+    std::vector<std::uint32_t> m_free;  // free cells, in no particular order
+    std::vector<std::uint32_t> m_slots; // per cell: position in m_free, or NOT_FREE
+};
+
+} // namespace Snake
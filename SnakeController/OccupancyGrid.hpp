@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SparseGrid.hpp"
+
+namespace Snake
+{
+
+// One bit per cell of the map, or for maps above DENSE_CELL_LIMIT cells a SparseGrid holding
+// just the occupied cells, so that memory follows the snake rather than the map area.
+class OccupancyGrid
+{
+public:
+    static constexpr std::size_t DENSE_CELL_LIMIT = std::size_t{1} << 26;
+
+    OccupancyGrid() = default;
+
+    OccupancyGrid(int p_width, int p_height)
+        : m_width(p_width),
+          m_height(p_height),
+          m_sparse(static_cast<std::size_t>(p_width) * static_cast<std::size_t>(p_height) > DENSE_CELL_LIMIT)
+    {
+        if (not m_sparse) {
+            m_words.resize((static_cast<std::size_t>(p_width) * static_cast<std::size_t>(p_height) + BITS_PER_WORD - 1) / BITS_PER_WORD);
+        }
+    }
+
+    bool isSparse() const noexcept { return m_sparse; }
+
+    bool isOccupied(int p_x, int p_y) const noexcept
+    {
+        if (not contains(p_x, p_y)) {
+            return false;
+        }
+        if (m_sparse) {
+            return m_cells.get(p_x, p_y);
+        }
+
+        auto const bit = index(p_x, p_y);
+        return m_words[bit / BITS_PER_WORD] & mask(bit);
+    }
+
+    // Hint that the cell is about to be looked at; does nothing off the map or when sparse.
+    void prefetch(int p_x, int p_y) const noexcept
+    {
+        if (contains(p_x, p_y) and not m_sparse) {
+            __builtin_prefetch(&m_words[index(p_x, p_y) / BITS_PER_WORD]);
+        }
+    }
+
+    void occupy(int p_x, int p_y)
+    {
+        if (not contains(p_x, p_y)) {
+            return;
+        }
+        if (m_sparse) {
+            m_cells.set(p_x, p_y, true);
+            return;
+        }
+
+        auto const bit = index(p_x, p_y);
+        m_words[bit / BITS_PER_WORD] |= mask(bit);
+    }
+
+    void release(int p_x, int p_y)
+    {
+        if (not contains(p_x, p_y)) {
+            return;
+        }
+        if (m_sparse) {
+            m_cells.set(p_x, p_y, false);
+            return;
+        }
+
+        auto const bit = index(p_x, p_y);
+        m_words[bit / BITS_PER_WORD] &= ~mask(bit);
+    }
+
+    std::size_t memoryUsage() const noexcept
+    {
+        return m_words.capacity() * sizeof(std::uint64_t) + m_cells.memoryUsage();
+    }
+
+private:
+    static constexpr std::size_t BITS_PER_WORD = 64;
+
+    bool contains(int p_x, int p_y) const noexcept
+    {
+        return p_x >= 0 and p_y >= 0 and p_x < m_width and p_y < m_height;
+    }
+
+    std::size_t index(int p_x, int p_y) const noexcept
+    {
+        return static_cast<std::size_t>(p_y) * static_cast<std::size_t>(m_width) + static_cast<std::size_t>(p_x);
+    }
+
+    static std::uint64_t mask(std::size_t p_bit) noexcept { return std::uint64_t{1} << (p_bit % BITS_PER_WORD); }
+
+    int m_width = 0;
+    int m_height = 0;
+    bool m_sparse = false;
+    std::vector<std::uint64_t> m_words;
+    SparseGrid<bool> m_cells;
+};
+
+} // namespace Snake
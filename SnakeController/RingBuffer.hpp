@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace Snake
+{
+
+template <class T>
+class RingBuffer
+{
+public:
+    bool empty() const noexcept { return m_size == 0; }
+    std::size_t size() const noexcept { return m_size; }
+
+    T& operator[](std::size_t p_index) noexcept { return m_buffer[physical(p_index)]; }
+    T const& operator[](std::size_t p_index) const noexcept { return m_buffer[physical(p_index)]; }
+
+    T& front() noexcept { return (*this)[0]; }
+    T const& front() const noexcept { return (*this)[0]; }
+
+    T& back() noexcept { return (*this)[m_size - 1]; }
+    T const& back() const noexcept { return (*this)[m_size - 1]; }
+
+    // Hint that the first and last elements are about to be touched.
+    void prefetchEnds() const noexcept
+    {
+        if (m_size != 0) {
+            __builtin_prefetch(&m_buffer[physical(0)]);
+            __builtin_prefetch(&m_buffer[physical(m_size - 1)]);
+        }
+    }
+
+    void push_front(T const& p_value)
+    {
+        if (m_size == m_buffer.size()) {
+            grow(m_size + 1);
+        }
+        m_head = (m_head + m_buffer.size() - 1) & (m_buffer.size() - 1);
+        m_buffer[m_head] = p_value;
+        ++m_size;
+    }
+
+    void push_back(T const& p_value)
+    {
+        if (m_size == m_buffer.size()) {
+            grow(m_size + 1);
+        }
+        m_buffer[physical(m_size)] = p_value;
+        ++m_size;
+    }
+
+    void pop_back(std::size_t p_count = 1) noexcept { m_size -= p_count; }
+
+    // Replaces the contents with p_count elements to be written through the returned pointer,
+    // front first, in one contiguous block.
+    T* assign(std::size_t p_count)
+    {
+        m_head = 0;
+        m_size = 0;
+        reserve(p_count);
+        m_size = p_count;
+        return m_buffer.data();
+    }
+
+    void reserve(std::size_t p_capacity)
+    {
+        if (p_capacity > m_buffer.size()) {
+            grow(p_capacity);
+        }
+    }
+
+private:
+    std::size_t physical(std::size_t p_index) const noexcept { return (m_head + p_index) & (m_buffer.size() - 1); }
+
+    void grow(std::size_t p_minCapacity)
+    {
+        std::size_t capacity = m_buffer.empty() ? 16 : m_buffer.size();
+        while (capacity < p_minCapacity) {
+            capacity *= 2;
+        }
+
+        std::vector<T> buffer(capacity);
+        for (std::size_t i = 0; i < m_size; ++i) {
+            buffer[i] = (*this)[i];
+        }
+
+        m_buffer.swap(buffer);
+        m_head = 0;
+    }
+
+    std::vector<T> m_buffer;
+    std::size_t m_head = 0;
+    std::size_t m_size = 0;
+};
+
+} // namespace Snake
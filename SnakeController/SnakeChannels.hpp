@@ -0,0 +1,16 @@
+#pragma once
+
+#include "SnakeInterface.hpp"
+#include "TypedChannel.hpp"
+
+namespace Snake
+{
+
+// Statically typed counterparts of the controller's ports. The display channel carries single
+// cells rather than DisplayBatchInd so that nothing on it needs the heap.
+using ControllerChannel = TypedChannel<TimeoutInd, DirectionInd, FoodInd, FoodResp>;
+using DisplayChannel = TypedChannel<DisplayInd>;
+using FoodChannel = TypedChannel<FoodReq>;
+using ScoreChannel = TypedChannel<ScoreInd, LooseInd>;
+
+} // namespace Snake
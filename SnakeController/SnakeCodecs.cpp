@@ -0,0 +1,52 @@
+#include "SnakeCodecs.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "EventCodecRegistry.hpp"
+#include "SnakeInterface.hpp"
+
+namespace Snake
+{
+namespace
+{
+
+// A DisplayBatchInd is stored as its DisplayInd cells back to back.
+void encodeDisplayBatch(Event const& p_event, std::vector<std::uint8_t>& p_bytes)
+{
+    auto const& cells = payload<DisplayBatchInd>(p_event).cells;
+    auto const bytes = reinterpret_cast<std::uint8_t const*>(cells.data());
+    p_bytes.insert(p_bytes.end(), bytes, bytes + cells.size() * sizeof(DisplayInd));
+}
+
+std::unique_ptr<Event> decodeDisplayBatch(std::uint8_t const* p_bytes, std::size_t p_size)
+{
+    if (p_size % sizeof(DisplayInd) != 0) {
+        throw std::invalid_argument("DisplayBatchInd payload is not a whole number of cells");
+    }
+
+    auto event = std::make_unique<EventT<DisplayBatchInd>>();
+    auto& cells = (*event)->cells;
+    cells.resize(p_size / sizeof(DisplayInd));
+    if (p_size) {
+        std::memcpy(cells.data(), p_bytes, p_size);
+    }
+    return event;
+}
+
+} // namespace
+
+void registerSnakeCodecs(EventCodecRegistry& p_codecs)
+{
+    p_codecs.add<DirectionInd>();
+    p_codecs.add<TimeoutInd>();
+    p_codecs.add<DisplayInd>();
+    p_codecs.add(DisplayBatchInd::MESSAGE_ID, &encodeDisplayBatch, &decodeDisplayBatch);
+    p_codecs.add<FoodInd>();
+    p_codecs.add<FoodReq>();
+    p_codecs.add<FoodResp>();
+    p_codecs.add<ScoreInd>();
+    p_codecs.add<LooseInd>();
+}
+
+} // namespace Snake
@@ -0,0 +1,11 @@
+#pragma once
+
+class EventCodecRegistry;
+
+namespace Snake
+{
+
+// Registers byte codecs for every message in SnakeInterface.hpp.
+void registerSnakeCodecs(EventCodecRegistry& p_codecs);
+
+} // namespace Snake
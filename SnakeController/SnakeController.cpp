@@ -1,195 +1,626 @@
 #include "SnakeController.hpp"
 
 #include <algorithm>
-#include <sstream>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
 
 #include "EventT.hpp"
 #include "IPort.hpp"
 
 namespace Snake
 {
-ConfigurationError::ConfigurationError()
-    : std::logic_error("Bad configuration of Snake::Controller.")
+ConfigurationError::ConfigurationError(std::size_t p_offset, char const* p_reason)
+    : std::logic_error("Bad configuration of Snake::Controller: " + std::string(p_reason) +
+                       " at offset " + std::to_string(p_offset) + "."),
+      offset(p_offset)
 {}
 
 UnexpectedEventException::UnexpectedEventException()
     : std::runtime_error("Unexpected event received!")
 {}
 
+namespace
+{
+// Reads "W w h F x y S d len x y ..." tokens straight out of the config, without copying it.
+class ConfigReader
+{
+public:
+    explicit ConfigReader(std::string_view p_config)
+        : m_config(p_config)
+    {}
+
+    void letter(char p_expected, char const* p_reason)
+    {
+        if (letter(p_reason) != p_expected) {
+            fail(m_offset - 1, p_reason);
+        }
+    }
+
+    char letter(char const* p_reason)
+    {
+        skipSpaces();
+        if (m_offset == m_config.size()) {
+            fail(m_offset, p_reason);
+        }
+        return m_config[m_offset++];
+    }
+
+    int number(char const* p_reason)
+    {
+        skipSpaces();
+        int value = 0;
+        auto const begin = m_config.data() + m_offset;
+        auto const end = m_config.data() + m_config.size();
+        auto const [next, error] = std::from_chars(begin, end, value);
+        if (error != std::errc()) {
+            fail(m_offset, p_reason);
+        }
+        m_offset += static_cast<std::size_t>(next - begin);
+        return value;
+    }
+
+    void end()
+    {
+        skipSpaces();
+        if (m_offset != m_config.size()) {
+            fail(m_offset, "unexpected trailing data");
+        }
+    }
+
+    std::size_t offset() const noexcept { return m_offset; }
+    std::size_t remaining() const noexcept { return m_config.size() - m_offset; }
+
+    [[noreturn]] void fail(std::size_t p_offset, char const* p_reason) const
+    {
+        throw ConfigurationError(p_offset, p_reason);
+    }
+
+private:
+    void skipSpaces() noexcept
+    {
+        while (m_offset < m_config.size() and isSpace(m_config[m_offset])) {
+            ++m_offset;
+        }
+    }
+
+    static bool isSpace(char p_char) noexcept
+    {
+        return p_char == ' ' or (p_char >= '\t' and p_char <= '\r');
+    }
+
+    std::string_view m_config;
+    std::size_t m_offset = 0;
+};
+
+} // namespace
+
+struct Controller::EventOutput : Output
+{
+    EventOutput(IPort& p_displayPort, IPort& p_foodPort, IPort& p_scorePort)
+        : m_displayPort(p_displayPort),
+          m_foodPort(p_foodPort),
+          m_scorePort(p_scorePort)
+    {}
+
+    void display(std::vector<DisplayInd> const& p_cells) override
+    {
+        m_displayPort.send(std::make_unique<EventT<DisplayBatchInd>>(DisplayBatchInd{p_cells}));
+    }
+
+    void send(FoodReq const& p_message) override { m_foodPort.send(std::make_unique<EventT<FoodReq>>(p_message)); }
+    void send(ScoreInd const& p_message) override { m_scorePort.send(std::make_unique<EventT<ScoreInd>>(p_message)); }
+    void send(LooseInd const& p_message) override { m_scorePort.send(std::make_unique<EventT<LooseInd>>(p_message)); }
+
+    IPort& m_displayPort;
+    IPort& m_foodPort;
+    IPort& m_scorePort;
+};
+
+struct Controller::ChannelOutput : Output
+{
+    ChannelOutput(DisplayChannel::IPort& p_displayPort, FoodChannel::IPort& p_foodPort, ScoreChannel::IPort& p_scorePort)
+        : m_displayPort(p_displayPort),
+          m_foodPort(p_foodPort),
+          m_scorePort(p_scorePort)
+    {}
+
+    void display(std::vector<DisplayInd> const& p_cells) override
+    {
+        for (auto const& cell : p_cells) {
+            m_displayPort.send(cell);
+        }
+    }
+
+    void send(FoodReq const& p_message) override { m_foodPort.send(p_message); }
+    void send(ScoreInd const& p_message) override { m_scorePort.send(p_message); }
+    void send(LooseInd const& p_message) override { m_scorePort.send(p_message); }
+
+    DisplayChannel::IPort& m_displayPort;
+    FoodChannel::IPort& m_foodPort;
+    ScoreChannel::IPort& m_scorePort;
+};
+
+namespace
+{
+template <class T>
+constexpr auto branchOf = ControllerInstrumentation::Branch_COUNT;
+template <>
+constexpr auto branchOf<TimeoutInd> = ControllerInstrumentation::Branch_TIMEOUT;
+template <>
+constexpr auto branchOf<DirectionInd> = ControllerInstrumentation::Branch_DIRECTION;
+template <>
+constexpr auto branchOf<FoodInd> = ControllerInstrumentation::Branch_FOOD_IND;
+template <>
+constexpr auto branchOf<FoodResp> = ControllerInstrumentation::Branch_FOOD_RESP;
+} // namespace
+
 Controller::Controller(IPort& p_displayPort, IPort& p_foodPort, IPort& p_scorePort, std::string const& p_config)
-    : m_displayPort(p_displayPort),
-      m_foodPort(p_foodPort),
-      m_scorePort(p_scorePort)
-{
-    std::istringstream istr(p_config);
-    char w, f, s, d;
-
-    int width, height, length;
-    int foodX, foodY;
-    istr >> w >> width >> height >> f >> foodX >> foodY >> s;
-
-    if (w == 'W' and f == 'F' and s == 'S') {
-        m_mapDimension = std::make_pair(width, height);
-        m_foodPosition = std::make_pair(foodX, foodY);
-
-        istr >> d;
-        switch (d) {
-            case 'U':
-                m_currentDirection = Direction_UP;
-                break;
-            case 'D':
-                m_currentDirection = Direction_DOWN;
-                break;
-            case 'L':
-                m_currentDirection = Direction_LEFT;
-                break;
-            case 'R':
-                m_currentDirection = Direction_RIGHT;
-                break;
-            default:
-                throw ConfigurationError();
-        }
-        istr >> length;
-
-        while (length) {
-            Segment seg;
-            istr >> seg.x >> seg.y;
-            seg.ttl = length--;
-
-            m_segments.push_back(seg);
+    : Controller(std::make_unique<EventOutput>(p_displayPort, p_foodPort, p_scorePort), p_config)
+{}
+
+Controller::Controller(IPort& p_displayPort, IPort& p_foodPort, IPort& p_scorePort, SnapshotView p_snapshot)
+    : Controller(std::make_unique<EventOutput>(p_displayPort, p_foodPort, p_scorePort), p_snapshot)
+{}
+
+Controller::Controller(DisplayChannel::IPort& p_displayPort, FoodChannel::IPort& p_foodPort,
+                       ScoreChannel::IPort& p_scorePort, std::string const& p_config)
+    : Controller(std::make_unique<ChannelOutput>(p_displayPort, p_foodPort, p_scorePort), p_config)
+{}
+
+Controller::Controller(DisplayChannel::IPort& p_displayPort, FoodChannel::IPort& p_foodPort,
+                       ScoreChannel::IPort& p_scorePort, SnapshotView p_snapshot)
+    : Controller(std::make_unique<ChannelOutput>(p_displayPort, p_foodPort, p_scorePort), p_snapshot)
+{}
+
+Controller::~Controller() = default;
+
+Controller::Controller(std::unique_ptr<Output> p_output, std::string const& p_config)
+    : m_output(std::move(p_output))
+{
+    ConfigReader config(p_config);
+
+    config.letter('W', "expected 'W'");
+    auto const dimensionOffset = config.offset();
+    int const width = config.number("expected map width");
+    int const height = config.number("expected map height");
+    if (width <= 0 or height <= 0) {
+        config.fail(dimensionOffset, "map dimensions must be positive");
+    }
+
+    config.letter('F', "expected 'F'");
+    int const foodX = config.number("expected food x");
+    int const foodY = config.number("expected food y");
+
+    config.letter('S', "expected 'S'");
+    switch (config.letter("expected snake direction")) {
+        case 'U':
+            m_currentDirection = Direction_UP;
+            break;
+        case 'D':
+            m_currentDirection = Direction_DOWN;
+            break;
+        case 'L':
+            m_currentDirection = Direction_LEFT;
+            break;
+        case 'R':
+            m_currentDirection = Direction_RIGHT;
+            break;
+        default:
+            config.fail(config.offset() - 1, "expected snake direction");
+    }
+
+    auto const lengthOffset = config.offset();
+    int length = config.number("expected snake length");
+    if (length <= 0) {
+        config.fail(lengthOffset, "snake length must be positive");
+    }
+
+    m_mapDimension = std::make_pair(width, height);
+    m_occupancy = OccupancyGrid(width, height);
+    m_foodPosition = std::make_pair(foodX, foodY);
+
+    // Every segment takes at least four characters, which bounds the reservation for lying lengths.
+    m_segments.reserve(std::min<std::size_t>(length, config.remaining() / 4 + 1));
+    while (length) {
+        auto const segmentOffset = config.offset();
+        Segment seg;
+        seg.x = config.number("expected segment x");
+        seg.y = config.number("expected segment y");
+        seg.releaseAt = length--;
+
+        if (seg.x < 0 or seg.y < 0 or seg.x >= width or seg.y >= height) {
+            config.fail(segmentOffset, "segment outside the map");
         }
-    } else {
-        throw ConfigurationError();
+        if (m_occupancy.isOccupied(seg.x, seg.y)) {
+            config.fail(segmentOffset, "segment on a cell the snake already takes");
+        }
+        if (not m_segments.empty() and
+            std::abs(seg.x - m_segments.back().x) + std::abs(seg.y - m_segments.back().y) != 1) {
+            config.fail(segmentOffset, "segment not adjacent to the previous one");
+        }
+
+        m_segments.push_back(seg);
+        m_occupancy.occupy(seg.x, seg.y);
     }
+
+    config.end();
 }
 
 void Controller::receive(std::unique_ptr<Event> e)
 {
-    try {
-        auto const& timerEvent = *dynamic_cast<EventT<TimeoutInd> const&>(*e);
+    auto const message = ControllerChannel::fromEvent(*e);
+    if (not message) {
+        if (m_instrumentation) {
+            m_instrumentation->countMessage(e->getMessageId());
+        }
+        throw UnexpectedEventException();
+    }
 
-        Segment const& currentHead = m_segments.front();
+    receive(*message);
+}
 
-        Segment newHead;
-        newHead.x = currentHead.x + ((m_currentDirection & 0b01) ? (m_currentDirection & 0b10) ? 1 : -1 : 0);
-        newHead.y = currentHead.y + (not (m_currentDirection & 0b01) ? (m_currentDirection & 0b10) ? 1 : -1 : 0);
-        newHead.ttl = currentHead.ttl;
+void Controller::receive(ControllerChannel::Message const& p_message)
+{
+    std::visit([this](auto const& p_payload) { process(p_payload); }, p_message);
+}
+
+template <class T>
+void Controller::process(T const& p_message)
+{
+    if (not m_instrumentation) {
+        handle(p_message);
+        return;
+    }
 
-        bool lost = false;
+    m_instrumentation->countMessage(T::MESSAGE_ID);
 
-        for (auto segment : m_segments) {
-            if (segment.x == newHead.x and segment.y == newHead.y) {
-                m_scorePort.send(std::make_unique<EventT<LooseInd>>());
-                lost = true;
-                break;
-            }
+    auto const start = std::chrono::steady_clock::now();
+    handle(p_message);
+    auto const elapsed = std::chrono::steady_clock::now() - start;
+
+    m_instrumentation->recordLatency(
+        branchOf<T>,
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    if constexpr (std::is_same_v<T, TimeoutInd>) {
+        m_instrumentation->recordSnakeLength(m_segments.size());
+    }
+}
+
+namespace
+{
+// Where tick() reports the cells it frees and occupies.
+struct DisplayChanges
+{
+    std::vector<DisplayInd>& cells;
+
+    void freed(int p_x, int p_y) { cells.push_back(DisplayInd{p_x, p_y, Cell_FREE}); }
+    void occupied(int p_x, int p_y) { cells.push_back(DisplayInd{p_x, p_y, Cell_SNAKE}); }
+};
+
+struct NoChanges
+{
+    void freed(int, int) noexcept {}
+    void occupied(int, int) noexcept {}
+};
+
+// Enough to tell the net effect of many ticks: the original segments that were freed, and the
+// number of heads added. The snake frees its tail first, so the first frees are the originals.
+struct NetChanges
+{
+    std::size_t originalSegments;
+    std::vector<std::pair<int, int>> freedOriginals;
+    std::size_t heads = 0;
+
+    void freed(int p_x, int p_y)
+    {
+        if (freedOriginals.size() < originalSegments) {
+            freedOriginals.emplace_back(p_x, p_y);
         }
+    }
+
+    void occupied(int, int) noexcept { ++heads; }
+};
+} // namespace
+
+void Controller::handle(TimeoutInd const&)
+{
+    m_displayCells.clear();
+    DisplayChanges changes{m_displayCells};
+    tick(changes);
+    sendDisplay();
+}
 
-        if (not lost) {
-            if (std::make_pair(newHead.x, newHead.y) == m_foodPosition) {
-                m_scorePort.send(std::make_unique<EventT<ScoreInd>>());
-                m_foodPort.send(std::make_unique<EventT<FoodReq>>());
-            } else if (newHead.x < 0 or newHead.y < 0 or
-                       newHead.x >= m_mapDimension.first or
-                       newHead.y >= m_mapDimension.second) {
-                m_scorePort.send(std::make_unique<EventT<LooseInd>>());
-                lost = true;
-            } else {
-                for (auto &segment : m_segments) {
-                    if (not --segment.ttl) {
-                        DisplayInd l_evt;
-                        l_evt.x = segment.x;
-                        l_evt.y = segment.y;
-                        l_evt.value = Cell_FREE;
-
-                        m_displayPort.send(std::make_unique<EventT<DisplayInd>>(l_evt));
-                    }
-                }
+void Controller::receiveBatch(std::unique_ptr<Event>* p_events, std::size_t p_count)
+{
+    if (m_instrumentation) {
+        IEventHandler::receiveBatch(p_events, p_count);
+        return;
+    }
+
+    std::size_t i = 0;
+    while (i < p_count) {
+        auto const messageId = p_events[i]->getMessageId();
+        auto end = i + 1;
+
+        if (messageId == TimeoutInd::MESSAGE_ID) {
+            while (end < p_count and p_events[end]->getMessageId() == TimeoutInd::MESSAGE_ID) {
+                p_events[end++].reset();
+            }
+            p_events[i].reset();
+
+            m_displayCells.clear();
+            DisplayChanges changes{m_displayCells};
+            for (auto k = i; k < end; ++k) {
+                tick(changes);
             }
+            sendDisplay();
+        } else if (messageId == DirectionInd::MESSAGE_ID) {
+            handle(payload<DirectionInd>(std::as_const(*p_events[i])));
+            p_events[i].reset();
+            while (end < p_count and p_events[end]->getMessageId() == DirectionInd::MESSAGE_ID) {
+                handle(payload<DirectionInd>(std::as_const(*p_events[end])));
+                p_events[end++].reset();
+            }
+        } else {
+            receive(std::move(p_events[i]));
         }
 
-        if (not lost) {
-            m_segments.push_front(newHead);
-            DisplayInd placeNewHead;
-            placeNewHead.x = newHead.x;
-            placeNewHead.y = newHead.y;
-            placeNewHead.value = Cell_SNAKE;
+        i = end;
+    }
+}
+
+AdvanceResult Controller::advance(std::uint64_t p_ticks, AdvanceDisplay p_display)
+{
+    m_displayCells.clear();
 
-            m_displayPort.send(std::make_unique<EventT<DisplayInd>>(placeNewHead));
+    if (p_display == AdvanceDisplay_NONE) {
+        NoChanges changes;
+        return run(p_ticks, changes);
+    }
 
-            m_segments.erase(
-                std::remove_if(
-                    m_segments.begin(),
-                    m_segments.end(),
-                    [](auto const& segment){ return not (segment.ttl > 0); }),
-                m_segments.end());
+    NetChanges changes{m_segments.size(), {}};
+    auto const result = run(p_ticks, changes);
+
+    // Placed food, if any, is already in m_displayCells and has to stay after the snake cells.
+    std::vector<DisplayInd> food;
+    food.swap(m_displayCells);
+
+    // A freed cell that the snake came back to is unchanged, both as a freed and as a new cell.
+    for (auto const& cell : changes.freedOriginals) {
+        if (not m_occupancy.isOccupied(cell.first, cell.second)) {
+            m_displayCells.push_back(DisplayInd{cell.first, cell.second, Cell_FREE});
         }
-    } catch (std::bad_cast&) {
-        try {
-            auto direction = dynamic_cast<EventT<DirectionInd> const&>(*e)->direction;
+    }
 
-            if ((m_currentDirection & 0b01) != (direction & 0b01)) {
-                m_currentDirection = direction;
-            }
-        } catch (std::bad_cast&) {
-            try {
-                auto receivedFood = *dynamic_cast<EventT<FoodInd> const&>(*e);
-
-                bool requestedFoodCollidedWithSnake = false;
-                for (auto const& segment : m_segments) {
-                    if (segment.x == receivedFood.x and segment.y == receivedFood.y) {
-                        requestedFoodCollidedWithSnake = true;
-                        break;
-                    }
-                }
-
-                if (requestedFoodCollidedWithSnake) {
-                    m_foodPort.send(std::make_unique<EventT<FoodReq>>());
-                } else {
-                    DisplayInd clearOldFood;
-                    clearOldFood.x = m_foodPosition.first;
-                    clearOldFood.y = m_foodPosition.second;
-                    clearOldFood.value = Cell_FREE;
-                    m_displayPort.send(std::make_unique<EventT<DisplayInd>>(clearOldFood));
-
-                    DisplayInd placeNewFood;
-                    placeNewFood.x = receivedFood.x;
-                    placeNewFood.y = receivedFood.y;
-                    placeNewFood.value = Cell_FOOD;
-                    m_displayPort.send(std::make_unique<EventT<DisplayInd>>(placeNewFood));
-                }
-
-                m_foodPosition = std::make_pair(receivedFood.x, receivedFood.y);
-
-            } catch (std::bad_cast&) {
-                try {
-                    auto requestedFood = *dynamic_cast<EventT<FoodResp> const&>(*e);
-
-                    bool requestedFoodCollidedWithSnake = false;
-                    for (auto const& segment : m_segments) {
-                        if (segment.x == requestedFood.x and segment.y == requestedFood.y) {
-                            requestedFoodCollidedWithSnake = true;
-                            break;
-                        }
-                    }
-
-                    if (requestedFoodCollidedWithSnake) {
-                        m_foodPort.send(std::make_unique<EventT<FoodReq>>());
-                    } else {
-                        DisplayInd placeNewFood;
-                        placeNewFood.x = requestedFood.x;
-                        placeNewFood.y = requestedFood.y;
-                        placeNewFood.value = Cell_FOOD;
-                        m_displayPort.send(std::make_unique<EventT<DisplayInd>>(placeNewFood));
-                    }
-
-                    m_foodPosition = std::make_pair(requestedFood.x, requestedFood.y);
-                } catch (std::bad_cast&) {
-                    throw UnexpectedEventException();
-                }
+    std::sort(changes.freedOriginals.begin(), changes.freedOriginals.end());
+    for (auto i = std::min(changes.heads, m_segments.size()); i-- > 0;) {
+        auto const cell = std::make_pair(m_segments[i].x, m_segments[i].y);
+        if (not std::binary_search(changes.freedOriginals.begin(), changes.freedOriginals.end(), cell)) {
+            m_displayCells.push_back(DisplayInd{cell.first, cell.second, Cell_SNAKE});
+        }
+    }
+    m_displayCells.insert(m_displayCells.end(), food.begin(), food.end());
+
+    sendDisplay();
+    return result;
+}
+
+// tick() in a loop, with the plain move onto a free cell kept in registers. Only the last tick,
+// which eats or loses, goes through tick() itself.
+template <class Changes>
+AdvanceResult Controller::run(std::uint64_t p_ticks, Changes& p_changes)
+{
+    int const dx = (m_currentDirection & 0b01) ? (m_currentDirection & 0b10) ? 1 : -1 : 0;
+    int const dy = not (m_currentDirection & 0b01) ? (m_currentDirection & 0b10) ? 1 : -1 : 0;
+
+    // Locals, because stores into the grid words could alias the members as far as the compiler knows.
+    auto const width = m_mapDimension.first;
+    auto const height = m_mapDimension.second;
+    auto const food = m_foodPosition;
+    auto const freeCells = m_foodPlacement ? &m_foodPlacement->freeCells : nullptr;
+    auto moves = m_moves;
+
+    AdvanceResult result{0, Tick_MOVED};
+    Segment head = m_segments.front();
+    while (result.ticks < p_ticks) {
+        ++result.ticks;
+
+        int const x = head.x + dx;
+        int const y = head.y + dy;
+        if (x < 0 or y < 0 or x >= width or y >= height or
+            m_occupancy.isOccupied(x, y) or std::make_pair(x, y) == food) {
+            m_moves = moves;
+            result.outcome = tick(p_changes);
+            return result;
+        }
+
+        head = Segment{x, y, head.releaseAt + 1};
+        ++moves;
+
+        // Frees the tail first, unlike releaseExpiredSegments(); only the net result is reported.
+        while (not m_segments.empty() and m_segments.back().releaseAt <= moves) {
+            auto const& segment = m_segments.back();
+            m_occupancy.release(segment.x, segment.y);
+            if (freeCells) {
+                freeCells->release(segment.x, segment.y);
             }
+            p_changes.freed(segment.x, segment.y);
+            m_segments.pop_back();
+        }
+
+        m_segments.push_front(head);
+        m_occupancy.occupy(x, y);
+        if (freeCells) {
+            freeCells->occupy(x, y);
         }
+        p_changes.occupied(x, y);
     }
+
+    m_moves = moves;
+    return result;
+}
+
+template <class Changes>
+TickOutcome Controller::tick(Changes& p_changes)
+{
+    Segment const& currentHead = m_segments.front();
+
+    Segment newHead;
+    newHead.x = currentHead.x + ((m_currentDirection & 0b01) ? (m_currentDirection & 0b10) ? 1 : -1 : 0);
+    newHead.y = currentHead.y + (not (m_currentDirection & 0b01) ? (m_currentDirection & 0b10) ? 1 : -1 : 0);
+    newHead.releaseAt = currentHead.releaseAt;
+
+    if (m_occupancy.isOccupied(newHead.x, newHead.y)) {
+        m_output->send(LooseInd{});
+        return Tick_LOST;
+    }
+
+    bool const ate = std::make_pair(newHead.x, newHead.y) == m_foodPosition;
+    if (ate) {
+        m_output->send(ScoreInd{});
+        if (not m_foodPlacement) {
+            m_output->send(FoodReq{});
+        }
+    } else if (newHead.x < 0 or newHead.y < 0 or
+               newHead.x >= m_mapDimension.first or
+               newHead.y >= m_mapDimension.second) {
+        m_output->send(LooseInd{});
+        return Tick_LOST;
+    } else {
+        ++m_moves;
+        ++newHead.releaseAt;
+        releaseExpiredSegments(p_changes);
+    }
+
+    m_segments.push_front(newHead);
+    m_occupancy.occupy(newHead.x, newHead.y);
+    if (m_foodPlacement) {
+        m_foodPlacement->freeCells.occupy(newHead.x, newHead.y);
+    }
+    p_changes.occupied(newHead.x, newHead.y);
+
+    if (not ate) {
+        return Tick_MOVED;
+    }
+
+    if (m_foodPlacement) {
+        placeFood();
+    }
+    return Tick_ATE;
+}
+
+template <class Changes>
+void Controller::releaseExpiredSegments(Changes& p_changes)
+{
+    // Segments never outlive the ones closer to the head, so the expired ones form the tail.
+    std::size_t expired = 0;
+    while (expired < m_segments.size() and
+           m_segments[m_segments.size() - 1 - expired].releaseAt <= m_moves) {
+        ++expired;
+    }
+
+    for (auto i = m_segments.size() - expired; i < m_segments.size(); ++i) {
+        auto const& segment = m_segments[i];
+        m_occupancy.release(segment.x, segment.y);
+        if (m_foodPlacement) {
+            m_foodPlacement->freeCells.release(segment.x, segment.y);
+        }
+
+        p_changes.freed(segment.x, segment.y);
+    }
+
+    m_segments.pop_back(expired);
+}
+
+void Controller::enableFoodPlacement(std::uint64_t p_seed)
+{
+    m_foodPlacement.reset(new FoodPlacement{
+        FreeCellIndex(m_mapDimension.first, m_mapDimension.second, m_occupancy),
+        std::mt19937_64(p_seed)});
+}
+
+void Controller::clearFood()
+{
+    // No food to clear after a full board left it off the map.
+    if (m_foodPosition.first >= 0 and m_foodPosition.second >= 0 and
+        m_foodPosition.first < m_mapDimension.first and m_foodPosition.second < m_mapDimension.second) {
+        m_displayCells.push_back(DisplayInd{m_foodPosition.first, m_foodPosition.second, Cell_FREE});
+    }
+}
+
+void Controller::placeFood()
+{
+    auto& placement = *m_foodPlacement;
+    if (placement.freeCells.size() == 0) {
+        // Nowhere to put it; a position off the map is never reached by the head.
+        m_foodPosition = std::make_pair(-1, -1);
+        return;
+    }
+
+    m_foodPosition = placement.freeCells.at(placement.random() % placement.freeCells.size());
+    m_displayCells.push_back(DisplayInd{m_foodPosition.first, m_foodPosition.second, Cell_FOOD});
+}
+
+void Controller::sendDisplay()
+{
+    if (not m_displayCells.empty()) {
+        m_output->display(m_displayCells);
+    }
+}
+
+void Controller::handle(DirectionInd const& p_message)
+{
+    auto direction = p_message.direction;
+
+    if ((m_currentDirection & 0b01) != (direction & 0b01)) {
+        m_currentDirection = direction;
+    }
+}
+
+void Controller::handle(FoodInd const& p_receivedFood)
+{
+    if (m_occupancy.isOccupied(p_receivedFood.x, p_receivedFood.y)) {
+        if (m_foodPlacement) {
+            m_displayCells.clear();
+            clearFood();
+            placeFood();
+            sendDisplay();
+            return;
+        }
+        m_output->send(FoodReq{});
+    } else {
+        m_displayCells.clear();
+        clearFood();
+        m_displayCells.push_back(DisplayInd{p_receivedFood.x, p_receivedFood.y, Cell_FOOD});
+        sendDisplay();
+    }
+
+    m_foodPosition = std::make_pair(p_receivedFood.x, p_receivedFood.y);
+}
+
+void Controller::handle(FoodResp const& p_requestedFood)
+{
+    if (m_occupancy.isOccupied(p_requestedFood.x, p_requestedFood.y)) {
+        if (m_foodPlacement) {
+            m_displayCells.clear();
+            clearFood();
+            placeFood();
+            sendDisplay();
+            return;
+        }
+        m_output->send(FoodReq{});
+    } else {
+        m_displayCells.clear();
+        m_displayCells.push_back(DisplayInd{p_requestedFood.x, p_requestedFood.y, Cell_FOOD});
+        sendDisplay();
+    }
+
+    m_foodPosition = std::make_pair(p_requestedFood.x, p_requestedFood.y);
 }
 
 } // namespace Snake
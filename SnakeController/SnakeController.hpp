@@ -1,10 +1,20 @@
 #pragma once
 
-#include <list>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <random>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "ControllerInstrumentation.hpp"
+#include "ControllerSnapshot.hpp"
+#include "FreeCellIndex.hpp"
 #include "IEventHandler.hpp"
+#include "OccupancyGrid.hpp"
+#include "RingBuffer.hpp"
+#include "SnakeChannels.hpp"
 #include "SnakeInterface.hpp"
 
 class Event;
@@ -14,41 +24,147 @@ namespace Snake
 {
 struct ConfigurationError : std::logic_error
 {
-    ConfigurationError();
+    ConfigurationError(std::size_t p_offset, char const* p_reason);
+
+    std::size_t offset; // position in the config string or snapshot where reading failed
 };
 
+// Checks the header of a controller snapshot and that all its segments are there.
+SnapshotHeader readSnapshotHeader(SnapshotView p_snapshot);
+
+// Marks the cells of the snapshot segments in p_occupancy, sized to the map, checking that they
+// are on the map, on distinct cells, and released no earlier than the ones behind them.
+void occupySnapshotSegments(SnapshotView p_snapshot, SnapshotHeader const& p_header, OccupancyGrid& p_occupancy);
+
 struct UnexpectedEventException : std::runtime_error
 {
     UnexpectedEventException();
 };
 
-class Controller : public IEventHandler
+enum TickOutcome
+{
+    Tick_MOVED,
+    Tick_ATE,
+    Tick_LOST
+};
+
+struct AdvanceResult
+{
+    std::uint64_t ticks;  // ticks made, the one that ate or lost included
+    TickOutcome outcome;  // of the last tick made
+};
+
+enum AdvanceDisplay
+{
+    AdvanceDisplay_NONE, // send no display events at all
+    AdvanceDisplay_NET   // send one batch with the cells that differ from before the call
+};
+
+class Controller : public IEventHandler, public ControllerChannel::IHandler
 {
 public:
     Controller(IPort& p_displayPort, IPort& p_foodPort, IPort& p_scorePort, std::string const& p_config);
+    Controller(IPort& p_displayPort, IPort& p_foodPort, IPort& p_scorePort, SnapshotView p_snapshot);
+
+    // Typed ports: messages travel by value and the controller allocates nothing per event.
+    Controller(DisplayChannel::IPort& p_displayPort, FoodChannel::IPort& p_foodPort, ScoreChannel::IPort& p_scorePort,
+               std::string const& p_config);
+    Controller(DisplayChannel::IPort& p_displayPort, FoodChannel::IPort& p_foodPort, ScoreChannel::IPort& p_scorePort,
+               SnapshotView p_snapshot);
+
+    ~Controller() override;
 
     Controller(Controller const& p_rhs) = delete;
     Controller& operator=(Controller const& p_rhs) = delete;
 
     void receive(std::unique_ptr<Event> e) override;
+    void receive(ControllerChannel::Message const& p_message) override;
+
+    // Same end state as receiving the events one by one, with less work per event: consecutive
+    // TimeoutInd tick back to back and send one display batch between them, and consecutive
+    // DirectionInd are folded. Food updates go one by one, as each one's display and FoodReq
+    // depend on the ones before it. With instrumentation attached all events go one by one.
+    void receiveBatch(std::unique_ptr<Event>* p_events, std::size_t p_count) override;
+
+    // Same as p_ticks TimeoutInd in a row, but stops early after the tick that eats or loses.
+    // Score and food events go out as usual; display events as chosen by p_display.
+    AdvanceResult advance(std::uint64_t p_ticks, AdvanceDisplay p_display = AdvanceDisplay_NONE);
+
+    std::size_t snapshotSize() const noexcept;
+    void saveSnapshot(void* p_buffer) const;
+    std::vector<std::uint8_t> saveSnapshot() const;
+
+    // From now on the controller places food itself, on a uniformly random free cell, whenever it
+    // would otherwise send FoodReq (after eating, or when offered food on the snake). Not stored
+    // in snapshots; enable it again after restoring. Throws std::length_error on maps over
+    // OccupancyGrid::DENSE_CELL_LIMIT cells.
+    void enableFoodPlacement(std::uint64_t p_seed);
+
+    // Starts feeding p_instrumentation from receive(), or stops when given nullptr.
+    void setInstrumentation(ControllerInstrumentation* p_instrumentation) noexcept { m_instrumentation = p_instrumentation; }
 
 private:
+    struct Output;
+    struct EventOutput;
+    struct ChannelOutput;
+
+    Controller(std::unique_ptr<Output> p_output, std::string const& p_config);
+    Controller(std::unique_ptr<Output> p_output, SnapshotView p_snapshot);
+
+    template <class T>
+    void process(T const& p_message);
+
+    void handle(TimeoutInd const& p_message);
+    void handle(DirectionInd const& p_message);
+    void handle(FoodInd const& p_message);
+    void handle(FoodResp const& p_message);
+
+    template <class Changes>
+    AdvanceResult run(std::uint64_t p_ticks, Changes& p_changes);
+    template <class Changes>
+    TickOutcome tick(Changes& p_changes);
+    template <class Changes>
+    void releaseExpiredSegments(Changes& p_changes);
+    void sendDisplay();
+    void clearFood();
+    void placeFood();
+
     struct Segment
     {
         int x;
         int y;
-        int ttl;
+        std::uint64_t releaseAt; // value of m_moves at which the segment leaves the board
     };
 
-    IPort& m_displayPort;
-    IPort& m_foodPort;
-    IPort& m_scorePort;
+    std::unique_ptr<Output> m_output;
+    std::vector<DisplayInd> m_displayCells; // cells changed by the event being handled, kept for its capacity
 
     std::pair<int, int> m_mapDimension;
     std::pair<int, int> m_foodPosition;
 
     Direction m_currentDirection;
-    std::list<Segment> m_segments;
+    RingBuffer<Segment> m_segments;
+    std::uint64_t m_moves = 0;
+    OccupancyGrid m_occupancy;
+
+    struct FoodPlacement
+    {
+        FreeCellIndex freeCells;
+        std::mt19937_64 random;
+    };
+    std::unique_ptr<FoodPlacement> m_foodPlacement;
+
+    ControllerInstrumentation* m_instrumentation = nullptr;
+};
+
+// Where the handlers' output goes: dynamic events on IPorts, or typed messages on channel ports.
+struct Controller::Output
+{
+    virtual ~Output() = default;
+    virtual void display(std::vector<DisplayInd> const& p_cells) = 0;
+    virtual void send(FoodReq const& p_message) = 0;
+    virtual void send(ScoreInd const& p_message) = 0;
+    virtual void send(LooseInd const& p_message) = 0;
 };
 
 } // namespace Snake
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 namespace Snake
 {
@@ -42,6 +43,14 @@ struct DisplayInd
     Cell value;
 };
 
+// All cell changes caused by a single event, in the order they happened.
+struct DisplayBatchInd
+{
+    static constexpr std::uint32_t MESSAGE_ID = 0x31;
+
+    std::vector<DisplayInd> cells;
+};
+
 struct FoodInd
 {
     static constexpr std::uint32_t MESSAGE_ID = 0x40;
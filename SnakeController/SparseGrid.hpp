@@ -0,0 +1,202 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Snake
+{
+
+// Cells of a map too large to store densely, in chunks of 8 x 8 kept in an open-addressing hash
+// table keyed by chunk coordinates. Only chunks holding a cell that differs from T() exist, so
+// memory follows the number of such cells and not the map area; lookups are one hash probe.
+// Coordinates must lie in [0, 2^31).
+template <class T>
+class SparseGrid
+{
+public:
+    static constexpr int CHUNK_SIDE = 8;
+
+    T get(int p_x, int p_y) const noexcept
+    {
+        auto const slot = find(chunkKey(p_x, p_y));
+        if (slot == NOT_FOUND) {
+            return T();
+        }
+        return m_chunks[m_slots[slot].chunk].cells[cellIndex(p_x, p_y)];
+    }
+
+    // Setting a cell back to T() frees its chunk once the whole chunk is back to T().
+    void set(int p_x, int p_y, T const& p_value)
+    {
+        auto const key = chunkKey(p_x, p_y);
+        auto slot = find(key);
+        if (slot == NOT_FOUND) {
+            if (p_value == T()) {
+                return;
+            }
+            slot = insert(key);
+        }
+
+        auto& chunk = m_chunks[m_slots[slot].chunk];
+        auto& cell = chunk.cells[cellIndex(p_x, p_y)];
+        bool const wasSet = not (cell == T());
+        bool const isSet = not (p_value == T());
+        cell = p_value;
+        chunk.used += static_cast<int>(isSet) - static_cast<int>(wasSet);
+
+        if (chunk.used == 0) {
+            erase(slot);
+        }
+    }
+
+    std::size_t chunkCount() const noexcept { return m_size; }
+
+    std::size_t memoryUsage() const noexcept
+    {
+        return m_slots.capacity() * sizeof(Slot) + m_chunks.capacity() * sizeof(Chunk) +
+               m_freeChunks.capacity() * sizeof(std::uint32_t);
+    }
+
+    // Calls p_visit(x, y, value) for every cell that differs from T(), in no particular order.
+    template <class Visit>
+    void forEach(Visit&& p_visit) const
+    {
+        for (auto const& slot : m_slots) {
+            if (slot.key == EMPTY) {
+                continue;
+            }
+            auto const baseX = static_cast<int>(slot.key & 0xFFFFFFFF) * CHUNK_SIDE;
+            auto const baseY = static_cast<int>(slot.key >> 32) * CHUNK_SIDE;
+            auto const& chunk = m_chunks[slot.chunk];
+            for (int i = 0; i < CHUNK_SIDE * CHUNK_SIDE; ++i) {
+                if (not (chunk.cells[i] == T())) {
+                    p_visit(baseX + i % CHUNK_SIDE, baseY + i / CHUNK_SIDE, chunk.cells[i]);
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr std::uint64_t EMPTY = ~std::uint64_t{0};
+    static constexpr std::size_t NOT_FOUND = ~std::size_t{0};
+
+    struct Slot
+    {
+        std::uint64_t key = EMPTY;
+        std::uint32_t chunk = 0;
+    };
+
+    struct Chunk
+    {
+        std::array<T, CHUNK_SIDE * CHUNK_SIDE> cells{};
+        int used = 0;
+    };
+
+    static std::uint64_t chunkKey(int p_x, int p_y) noexcept
+    {
+        return std::uint64_t{static_cast<std::uint32_t>(p_y / CHUNK_SIDE)} << 32 |
+               static_cast<std::uint32_t>(p_x / CHUNK_SIDE);
+    }
+
+    static int cellIndex(int p_x, int p_y) noexcept
+    {
+        return p_y % CHUNK_SIDE * CHUNK_SIDE + p_x % CHUNK_SIDE;
+    }
+
+    std::size_t home(std::uint64_t p_key) const noexcept
+    {
+        // Fibonacci hashing spreads neighbouring chunks over the table.
+        return static_cast<std::size_t>((p_key * 0x9E3779B97F4A7C15ull) >> m_shift);
+    }
+
+    std::size_t find(std::uint64_t p_key) const noexcept
+    {
+        if (m_slots.empty()) {
+            return NOT_FOUND;
+        }
+        auto const mask = m_slots.size() - 1;
+        for (auto slot = home(p_key);; slot = (slot + 1) & mask) {
+            if (m_slots[slot].key == p_key) {
+                return slot;
+            }
+            if (m_slots[slot].key == EMPTY) {
+                return NOT_FOUND;
+            }
+        }
+    }
+
+    std::size_t insert(std::uint64_t p_key)
+    {
+        if ((m_size + 1) * 2 > m_slots.size()) {
+            rehash(m_slots.empty() ? 16 : m_slots.size() * 2);
+        }
+
+        std::uint32_t chunk;
+        if (m_freeChunks.empty()) {
+            chunk = static_cast<std::uint32_t>(m_chunks.size());
+            m_chunks.emplace_back();
+        } else {
+            chunk = m_freeChunks.back();
+            m_freeChunks.pop_back();
+        }
+
+        auto const slot = place(p_key, chunk);
+        ++m_size;
+        return slot;
+    }
+
+    std::size_t place(std::uint64_t p_key, std::uint32_t p_chunk) noexcept
+    {
+        auto const mask = m_slots.size() - 1;
+        auto slot = home(p_key);
+        while (m_slots[slot].key != EMPTY) {
+            slot = (slot + 1) & mask;
+        }
+        m_slots[slot] = Slot{p_key, p_chunk};
+        return slot;
+    }
+
+    // Backward-shift deletion keeps probe sequences intact without tombstones.
+    void erase(std::size_t p_slot)
+    {
+        m_freeChunks.push_back(m_slots[p_slot].chunk);
+        --m_size;
+
+        auto const mask = m_slots.size() - 1;
+        auto hole = p_slot;
+        for (auto next = (hole + 1) & mask; m_slots[next].key != EMPTY; next = (next + 1) & mask) {
+            auto const wanted = home(m_slots[next].key);
+            // Move the entry into the hole unless its home lies cyclically in (hole, next].
+            if (((next - wanted) & mask) >= ((next - hole) & mask)) {
+                m_slots[hole] = m_slots[next];
+                hole = next;
+            }
+        }
+        m_slots[hole] = Slot{};
+    }
+
+    void rehash(std::size_t p_capacity)
+    {
+        std::vector<Slot> old(p_capacity);
+        old.swap(m_slots);
+        m_shift = 64;
+        for (auto capacity = p_capacity; capacity > 1; capacity /= 2) {
+            --m_shift;
+        }
+        for (auto const& slot : old) {
+            if (slot.key != EMPTY) {
+                place(slot.key, slot.chunk);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::vector<Chunk> m_chunks;
+    std::vector<std::uint32_t> m_freeChunks;
+    std::size_t m_size = 0;
+    unsigned m_shift = 64;
+};
+
+} // namespace Snake
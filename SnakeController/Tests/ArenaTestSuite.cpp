@@ -0,0 +1,143 @@
+#include "Arena.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+#include "Mocks/PortMock.hpp"
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+static bool operator==(ArenaOutcome const& p_lhs, ArenaOutcome const& p_rhs)
+{
+    return p_lhs.snake == p_rhs.snake and p_lhs.outcome == p_rhs.outcome;
+}
+
+TEST(ArenaTest, test_AddSnake_RejectsTakenOrBrokenBodies)
+{
+    Arena sut(10, 10);
+    sut.addSnake({{2, 2}, {1, 2}}, Direction_RIGHT);
+
+    EXPECT_THROW(sut.addSnake({}, Direction_RIGHT), std::invalid_argument);
+    EXPECT_THROW(sut.addSnake({{1, 2}}, Direction_RIGHT), std::invalid_argument);
+    EXPECT_THROW(sut.addSnake({{10, 2}}, Direction_RIGHT), std::invalid_argument);
+    EXPECT_THROW(sut.addSnake({{5, 5}, {7, 5}}, Direction_RIGHT), std::invalid_argument);
+    EXPECT_THROW(sut.addSnake({{5, 5}, {5, 6}, {5, 5}}, Direction_RIGHT), std::invalid_argument);
+    EXPECT_EQ(1u, sut.aliveCount());
+}
+
+TEST(ArenaTest, test_Tick_MovesAllSnakesAndReportsChangedCells)
+{
+    Arena sut(10, 10);
+    auto const a = sut.addSnake({{2, 2}, {1, 2}}, Direction_RIGHT);
+    auto const b = sut.addSnake({{5, 5}, {5, 6}}, Direction_UP);
+
+    std::vector<ArenaOutcome> const expected = {{a, Tick_MOVED}, {b, Tick_MOVED}};
+    EXPECT_EQ(expected, sut.tick());
+
+    EXPECT_EQ(std::make_pair(3, 2), sut.head(a));
+    EXPECT_EQ(std::make_pair(5, 4), sut.head(b));
+    ASSERT_EQ(4u, sut.displayChanges().size());
+    EXPECT_EQ(1, sut.displayChanges()[0].x);
+    EXPECT_EQ(Cell_FREE, sut.displayChanges()[0].value);
+    EXPECT_EQ(5, sut.displayChanges()[3].x);
+    EXPECT_EQ(4, sut.displayChanges()[3].y);
+    EXPECT_EQ(Cell_SNAKE, sut.displayChanges()[3].value);
+}
+
+TEST(ArenaTest, test_HeadIntoOtherBody_LosesAndClearsTheLoser)
+{
+    Arena sut(10, 10);
+    auto const a = sut.addSnake({{4, 3}, {3, 3}}, Direction_RIGHT);
+    auto const b = sut.addSnake({{5, 4}, {5, 3}, {5, 2}}, Direction_DOWN);
+
+    std::vector<ArenaOutcome> const expected = {{a, Tick_LOST}, {b, Tick_MOVED}};
+    EXPECT_EQ(expected, sut.tick());
+
+    EXPECT_FALSE(sut.isAlive(a));
+    EXPECT_EQ(1u, sut.aliveCount());
+
+    // Cells of the loser are free again.
+    sut.setDirection(b, Direction_LEFT);
+    sut.tick();
+    sut.setDirection(b, Direction_UP);
+    sut.tick();
+    EXPECT_EQ(Tick_MOVED, sut.tick().front().outcome);
+    EXPECT_EQ(std::make_pair(4, 3), sut.head(b));
+}
+
+TEST(ArenaTest, test_HeadsMeetingOnOneCell_BothLose)
+{
+    Arena sut(10, 10);
+    auto const a = sut.addSnake({{2, 5}}, Direction_RIGHT);
+    auto const b = sut.addSnake({{6, 5}}, Direction_LEFT);
+    auto const c = sut.addSnake({{8, 0}, {9, 0}}, Direction_LEFT);
+    sut.placeFood(4, 5);
+    sut.placeFood(7, 0);
+
+    std::vector<ArenaOutcome> const first = {{a, Tick_MOVED}, {b, Tick_MOVED}, {c, Tick_ATE}};
+    EXPECT_EQ(first, sut.tick());
+    std::vector<ArenaOutcome> const second = {{a, Tick_LOST}, {b, Tick_LOST}, {c, Tick_MOVED}};
+    EXPECT_EQ(second, sut.tick());
+    EXPECT_EQ(1u, sut.aliveCount());
+    EXPECT_EQ(3u, sut.length(c));
+}
+
+TEST(ArenaTest, test_Food_GrowsTheSnakeThatEatsIt)
+{
+    Arena sut(10, 10);
+    auto const a = sut.addSnake({{2, 2}, {1, 2}}, Direction_RIGHT);
+    EXPECT_TRUE(sut.placeFood(3, 2));
+    EXPECT_FALSE(sut.placeFood(1, 2));
+
+    EXPECT_EQ(Tick_ATE, sut.tick().front().outcome);
+    EXPECT_EQ(3u, sut.length(a));
+    EXPECT_EQ(Tick_MOVED, sut.tick().front().outcome);
+    EXPECT_EQ(3u, sut.length(a));
+}
+
+TEST(ArenaTest, test_OneSnake_GrowsAsAController)
+{
+    NiceMock<PortMock> portMock;
+    Controller controller(portMock, portMock, portMock, "W 20 10 F 3 2 S R 2 2 2 1 2");
+    Arena sut(20, 10);
+    auto const a = sut.addSnake({{2, 2}, {1, 2}}, Direction_RIGHT);
+    sut.placeFood(3, 2);
+
+    // Eats twice in a row and once more later, then moves on until the snake is back to its length.
+    for (int tick = 0; tick < 9; ++tick) {
+        if (tick == 1 or tick == 4) {
+            controller.receive(std::make_unique<EventT<FoodInd>>(FoodInd{3 + tick, 2}));
+            sut.placeFood(3 + tick, 2);
+        }
+
+        ASSERT_EQ(controller.advance(1).outcome, sut.tick().front().outcome) << "tick " << tick;
+
+        auto const snapshot = controller.saveSnapshot();
+        SnapshotHeader header;
+        SnapshotSegment head;
+        std::memcpy(&header, snapshot.data(), sizeof(header));
+        std::memcpy(&head, snapshot.data() + sizeof(header), sizeof(head));
+        EXPECT_EQ(header.segmentCount, sut.length(a)) << "tick " << tick;
+        EXPECT_EQ(std::make_pair(head.x, head.y), sut.head(a)) << "tick " << tick;
+    }
+    EXPECT_EQ(2u, sut.length(a));
+}
+
+TEST(ArenaTest, test_LeavingTheMap_Loses)
+{
+    Arena sut(3, 3);
+    auto const a = sut.addSnake({{2, 0}}, Direction_RIGHT);
+
+    EXPECT_EQ(Tick_LOST, sut.tick().front().outcome);
+    EXPECT_FALSE(sut.isAlive(a));
+    EXPECT_TRUE(sut.tick().empty());
+}
+
+} // namespace Snake
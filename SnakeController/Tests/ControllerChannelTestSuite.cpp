@@ -0,0 +1,106 @@
+#include "SnakeController.hpp"
+
+#include <vector>
+
+#include "SnakeChannels.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+static bool operator==(DisplayInd const& p_lhs, DisplayInd const& p_rhs)
+{
+    return p_lhs.x == p_rhs.x and p_lhs.y == p_rhs.y and p_lhs.value == p_rhs.value;
+}
+
+namespace
+{
+
+template <class Channel>
+struct RecordingChannelPort : Channel::IPort
+{
+    void send(typename Channel::Message const& p_message) override { messages.push_back(p_message); }
+
+    std::vector<typename Channel::Message> messages;
+};
+} // namespace
+
+struct ControllerChannelTest : Test
+{
+    RecordingChannelPort<DisplayChannel> displayPort;
+    RecordingChannelPort<FoodChannel> foodPort;
+    RecordingChannelPort<ScoreChannel> scorePort;
+    Controller sut{displayPort, foodPort, scorePort, "W 10 10 F 5 5 S R 3 3 0 2 0 1 0"};
+
+    std::vector<DisplayInd> displayed() const
+    {
+        std::vector<DisplayInd> cells;
+        for (auto const& message : displayPort.messages) {
+            cells.push_back(std::get<DisplayInd>(message));
+        }
+        return cells;
+    }
+};
+
+TEST_F(ControllerChannelTest, test_Timeout_DisplaysSingleCells)
+{
+    sut.receive(TimeoutInd{});
+
+    std::vector<DisplayInd> const expected = {{1, 0, Cell_FREE}, {4, 0, Cell_SNAKE}};
+    EXPECT_EQ(expected, displayed());
+    EXPECT_TRUE(foodPort.messages.empty());
+    EXPECT_TRUE(scorePort.messages.empty());
+}
+
+TEST_F(ControllerChannelTest, test_EatingFood_ScoresAndRequestsNewFood)
+{
+    sut.receive(FoodResp{4, 0});
+    sut.receive(TimeoutInd{});
+
+    ASSERT_EQ(1u, scorePort.messages.size());
+    EXPECT_TRUE(std::holds_alternative<ScoreInd>(scorePort.messages[0]));
+    EXPECT_EQ(1u, foodPort.messages.size());
+
+    std::vector<DisplayInd> const expected = {{4, 0, Cell_FOOD}, {4, 0, Cell_SNAKE}};
+    EXPECT_EQ(expected, displayed());
+}
+
+TEST_F(ControllerChannelTest, test_HittingWall_Looses)
+{
+    sut.receive(DirectionInd{Direction_UP});
+    sut.receive(TimeoutInd{});
+
+    ASSERT_EQ(1u, scorePort.messages.size());
+    EXPECT_TRUE(std::holds_alternative<LooseInd>(scorePort.messages[0]));
+}
+
+TEST_F(ControllerChannelTest, test_DynamicEvents_AreAcceptedToo)
+{
+    sut.receive(std::make_unique<EventT<FoodInd>>(FoodInd{7, 7}));
+
+    std::vector<DisplayInd> const expected = {{5, 5, Cell_FREE}, {7, 7, Cell_FOOD}};
+    EXPECT_EQ(expected, displayed());
+}
+
+TEST_F(ControllerChannelTest, test_FoodPlacement_IsReproducibleForSeed)
+{
+    RecordingChannelPort<DisplayChannel> otherDisplayPort;
+    Controller other{otherDisplayPort, foodPort, scorePort, "W 10 10 F 5 5 S R 3 3 0 2 0 1 0"};
+    sut.enableFoodPlacement(42);
+    other.enableFoodPlacement(42);
+
+    sut.receive(FoodInd{2, 0});
+    other.receive(FoodInd{2, 0});
+
+    ASSERT_EQ(2u, displayPort.messages.size());
+    auto const food = std::get<DisplayInd>(displayPort.messages[1]);
+    EXPECT_EQ(Cell_FOOD, food.value);
+    EXPECT_FALSE(food.y == 0 and food.x >= 1 and food.x <= 3);
+    EXPECT_TRUE(food == std::get<DisplayInd>(otherDisplayPort.messages[1]));
+    EXPECT_TRUE(foodPort.messages.empty());
+}
+
+} // namespace Snake
@@ -0,0 +1,96 @@
+#include "SnakeController.hpp"
+
+#include "ControllerInstrumentation.hpp"
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+#include "Mocks/PortMock.hpp"
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+struct ControllerInstrumentationTest : Test
+{
+    NiceMock<PortMock> portMock;
+    ControllerInstrumentation instrumentation;
+    InstrumentedPort displayPort{instrumentation, ControllerInstrumentation::Port_DISPLAY, portMock};
+    InstrumentedPort foodPort{instrumentation, ControllerInstrumentation::Port_FOOD, portMock};
+    InstrumentedPort scorePort{instrumentation, ControllerInstrumentation::Port_SCORE, portMock};
+    Controller sut{displayPort, foodPort, scorePort, "W 10 10 F 5 5 S R 3 3 0 2 0 1 0"};
+
+    EventT<TimeoutInd> te;
+
+    ControllerInstrumentationTest()
+    {
+        sut.setInstrumentation(&instrumentation);
+    }
+};
+
+TEST_F(ControllerInstrumentationTest, test_CountsMessagesAndBranchLatencies)
+{
+    sut.receive(te.clone());
+    sut.receive(te.clone());
+    sut.receive(std::make_unique<EventT<DirectionInd>>(DirectionInd{Direction_DOWN}));
+
+    auto const totals = instrumentation.totals();
+    EXPECT_EQ(2u, totals->messages[TimeoutInd::MESSAGE_ID]);
+    EXPECT_EQ(1u, totals->messages[DirectionInd::MESSAGE_ID]);
+    EXPECT_EQ(2u, totals->latency[ControllerInstrumentation::Branch_TIMEOUT].count());
+    EXPECT_EQ(1u, totals->latency[ControllerInstrumentation::Branch_DIRECTION].count());
+    EXPECT_EQ(0u, totals->latency[ControllerInstrumentation::Branch_FOOD_IND].count());
+}
+
+TEST_F(ControllerInstrumentationTest, test_CountsSentEventsPerPort)
+{
+    sut.receive(std::make_unique<EventT<FoodResp>>(FoodResp{4, 0}));
+    sut.receive(te.clone());
+
+    auto const totals = instrumentation.totals();
+    EXPECT_EQ(2u, totals->sent[ControllerInstrumentation::Port_DISPLAY]);
+    EXPECT_EQ(1u, totals->sent[ControllerInstrumentation::Port_FOOD]);
+    EXPECT_EQ(1u, totals->sent[ControllerInstrumentation::Port_SCORE]);
+}
+
+TEST_F(ControllerInstrumentationTest, test_RecordsSnakeLengthAfterEachTick)
+{
+    sut.receive(te.clone());
+
+    auto const totals = instrumentation.totals();
+    EXPECT_EQ(1u, totals->snakeLength.count());
+    EXPECT_EQ(3u, totals->snakeLength.max());
+}
+
+TEST_F(ControllerInstrumentationTest, test_UnexpectedEvent_IsCountedBeforeThrowing)
+{
+    EXPECT_THROW(sut.receive(std::make_unique<EventT<FoodReq>>()), UnexpectedEventException);
+
+    EXPECT_EQ(1u, instrumentation.totals()->messages[FoodReq::MESSAGE_ID]);
+}
+
+TEST_F(ControllerInstrumentationTest, test_Detached_RecordsNothing)
+{
+    sut.setInstrumentation(nullptr);
+    sut.receive(te.clone());
+
+    EXPECT_EQ(0u, instrumentation.totals()->messages[TimeoutInd::MESSAGE_ID]);
+}
+
+TEST_F(ControllerInstrumentationTest, test_Dumps_ListBranchesAndPorts)
+{
+    sut.receive(te.clone());
+
+    auto const text = instrumentation.dumpText();
+    EXPECT_NE(std::string::npos, text.find("timeout: count=1"));
+    EXPECT_NE(std::string::npos, text.find("display: 1"));
+
+    auto const json = instrumentation.dumpJson();
+    EXPECT_EQ('{', json.front());
+    EXPECT_EQ('}', json.back());
+    EXPECT_NE(std::string::npos, json.find("\"timeout\": {\"count\": 1"));
+    EXPECT_NE(std::string::npos, json.find("\"display\": 1"));
+}
+
+} // namespace Snake
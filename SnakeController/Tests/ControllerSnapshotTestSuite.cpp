@@ -0,0 +1,129 @@
+#include "SnakeController.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include "DisplayBatchAdapter.hpp"
+#include "EventT.hpp"
+#include "MappedFile.hpp"
+
+#include <gtest/gtest.h>
+
+#include "Mocks/PortMock.hpp"
+#include "Mocks/EventMatchers.hpp"
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+struct ControllerSnapshotTest : Test
+{
+    EventT<TimeoutInd> te;
+
+    NiceMock<PortMock> originalPortMock;
+    StrictMock<PortMock> displayPortMock;
+    StrictMock<PortMock> foodPortMock;
+    StrictMock<PortMock> scorePortMock;
+    DisplayBatchAdapter displayPort{displayPortMock};
+
+    // Snake of five heading right that has already made two moves.
+    std::vector<std::uint8_t> snapshotAfterTwoMoves()
+    {
+        Controller original(originalPortMock, originalPortMock, originalPortMock,
+                            "W 100 100 F 50 50 S R 5 20 20 19 20 18 20 17 20 16 20");
+        original.receive(te.clone());
+        original.receive(te.clone());
+        return original.saveSnapshot();
+    }
+
+    std::unique_ptr<Controller> restore(void const* p_data, std::size_t p_size)
+    {
+        return std::make_unique<Controller>(displayPort, foodPortMock, scorePortMock, SnapshotView{p_data, p_size});
+    }
+};
+
+TEST_F(ControllerSnapshotTest, test_RestoredController_ContinuesWhereOriginalStopped)
+{
+    auto const snapshot = snapshotAfterTwoMoves();
+    auto sut = restore(snapshot.data(), snapshot.size());
+
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(18, 20, Cell_FREE)));
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(23, 20, Cell_SNAKE)));
+
+    sut->receive(te.clone());
+}
+
+TEST_F(ControllerSnapshotTest, test_RestoredController_KnowsItsFoodAndBody)
+{
+    auto const snapshot = snapshotAfterTwoMoves();
+    auto sut = restore(snapshot.data(), snapshot.size());
+
+    EXPECT_CALL(foodPortMock, send_rvr(AnyFoodReq()));
+    sut->receive(std::make_unique<EventT<FoodResp>>(FoodResp{19, 20}));
+
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(50, 50, Cell_FOOD)));
+    sut->receive(std::make_unique<EventT<FoodResp>>(FoodResp{50, 50}));
+}
+
+TEST_F(ControllerSnapshotTest, test_RestoreFromMappedFile)
+{
+    auto const path = ::testing::TempDir() + "controller_snapshot.bin";
+    auto const snapshot = snapshotAfterTwoMoves();
+    {
+        auto file = MappedFile::create(path, snapshot.size());
+        std::copy(snapshot.begin(), snapshot.end(), file.data());
+    }
+
+    auto const file = MappedFile::openReadOnly(path);
+    auto sut = restore(file.data(), file.size());
+    std::remove(path.c_str());
+
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(18, 20, Cell_FREE)));
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(23, 20, Cell_SNAKE)));
+
+    sut->receive(te.clone());
+}
+
+TEST_F(ControllerSnapshotTest, test_ForeignData_ThrowsException)
+{
+    auto snapshot = snapshotAfterTwoMoves();
+    snapshot[0] = 'X';
+
+    EXPECT_THROW(restore(snapshot.data(), snapshot.size()), ConfigurationError);
+}
+
+TEST_F(ControllerSnapshotTest, test_TruncatedSnapshot_ThrowsException)
+{
+    auto const snapshot = snapshotAfterTwoMoves();
+
+    EXPECT_THROW(restore(snapshot.data(), sizeof(SnapshotHeader) - 1), ConfigurationError);
+    EXPECT_THROW(restore(snapshot.data(), snapshot.size() - 1), ConfigurationError);
+}
+
+TEST_F(ControllerSnapshotTest, test_InconsistentSegments_ThrowException)
+{
+    auto const segmentAt = [](std::vector<std::uint8_t>& p_snapshot, std::size_t p_index) {
+        return p_snapshot.data() + sizeof(SnapshotHeader) + p_index * sizeof(SnapshotSegment);
+    };
+
+    auto duplicated = snapshotAfterTwoMoves();
+    std::memcpy(segmentAt(duplicated, 1), segmentAt(duplicated, 0), 2 * sizeof(std::int32_t));
+    EXPECT_THROW(restore(duplicated.data(), duplicated.size()), ConfigurationError);
+
+    auto reordered = snapshotAfterTwoMoves();
+    SnapshotSegment tail;
+    std::memcpy(&tail, segmentAt(reordered, 4), sizeof(tail));
+    tail.releaseAt += 100;
+    std::memcpy(segmentAt(reordered, 4), &tail, sizeof(tail));
+    EXPECT_THROW(restore(reordered.data(), reordered.size()), ConfigurationError);
+
+    auto detached = snapshotAfterTwoMoves();
+    SnapshotSegment last;
+    std::memcpy(&last, segmentAt(detached, 4), sizeof(last));
+    last.y += 10;
+    std::memcpy(segmentAt(detached, 4), &last, sizeof(last));
+    EXPECT_THROW(restore(detached.data(), detached.size()), ConfigurationError);
+}
+
+} // namespace Snake
@@ -0,0 +1,42 @@
+#include "DisplayBatchAdapter.hpp"
+
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+#include "Mocks/PortMock.hpp"
+#include "Mocks/EventMatchers.hpp"
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+struct DisplayBatchAdapterTest : Test
+{
+    StrictMock<PortMock> displayPortMock;
+    DisplayBatchAdapter sut{displayPortMock};
+};
+
+TEST_F(DisplayBatchAdapterTest, test_Batch_IsExpandedToDisplayIndsInOrder)
+{
+    DisplayBatchInd l_batch;
+    l_batch.cells = {{1, 2, Cell_FREE}, {3, 4, Cell_SNAKE}};
+
+    InSequence l_seq;
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(1, 2, Cell_FREE)));
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(3, 4, Cell_SNAKE)));
+
+    sut.send(std::make_unique<EventT<DisplayBatchInd>>(l_batch));
+}
+
+TEST_F(DisplayBatchAdapterTest, test_OtherEvents_AreForwardedUnchanged)
+{
+    DisplayInd l_displayInd{5, 6, Cell_FOOD};
+
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(5, 6, Cell_FOOD)));
+
+    sut.send(std::make_unique<EventT<DisplayInd>>(l_displayInd));
+}
+
+} // namespace Snake
@@ -0,0 +1,73 @@
+#include "FreeCellIndex.hpp"
+
+#include <set>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace Snake
+{
+namespace
+{
+
+std::set<std::pair<int, int>> freeCells(FreeCellIndex const& p_index)
+{
+    std::set<std::pair<int, int>> cells;
+    for (std::size_t i = 0; i < p_index.size(); ++i) {
+        cells.insert(p_index.at(i));
+    }
+    return cells;
+}
+
+} // namespace
+
+TEST(FreeCellIndexTest, test_NewIndex_ListsCellsFreeInGrid)
+{
+    OccupancyGrid grid(3, 2);
+    grid.occupy(0, 0);
+    grid.occupy(2, 1);
+
+    FreeCellIndex index(3, 2, grid);
+
+    std::set<std::pair<int, int>> const expected = {{1, 0}, {2, 0}, {0, 1}, {1, 1}};
+    EXPECT_EQ(expected, freeCells(index));
+}
+
+TEST(FreeCellIndexTest, test_OccupyAndRelease_UpdateFreeCells)
+{
+    FreeCellIndex index(2, 2, OccupancyGrid(2, 2));
+
+    index.occupy(0, 0);
+    index.occupy(1, 1);
+    std::set<std::pair<int, int>> const afterOccupy = {{1, 0}, {0, 1}};
+    EXPECT_EQ(afterOccupy, freeCells(index));
+
+    index.release(0, 0);
+    std::set<std::pair<int, int>> const afterRelease = {{0, 0}, {1, 0}, {0, 1}};
+    EXPECT_EQ(afterRelease, freeCells(index));
+}
+
+TEST(FreeCellIndexTest, test_RepeatedAndOffMapUpdates_AreIgnored)
+{
+    FreeCellIndex index(2, 2, OccupancyGrid(2, 2));
+
+    index.occupy(1, 0);
+    index.occupy(1, 0);
+    index.release(0, 0);
+    index.occupy(-1, 0);
+    index.release(2, 0);
+
+    EXPECT_EQ(3u, index.size());
+}
+
+TEST(FreeCellIndexTest, test_MapStoredSparsely_IsRefused)
+{
+    OccupancyGrid grid(10000, 10000);
+    ASSERT_TRUE(grid.isSparse());
+
+    EXPECT_THROW(FreeCellIndex(10000, 10000, grid), std::length_error);
+}
+
+} // namespace Snake
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "EventT.hpp"
 #include "SnakeInterface.hpp"
 
@@ -9,13 +11,31 @@ namespace Snake
 {
 
 MATCHER_P3(DisplayIndEq, p_x, p_y, p_value, "")
-try {
-    auto const& l_msg = payload<DisplayInd>(arg);
+{
+    auto const l_event = event_cast<DisplayInd>(arg);
+    if (not l_event) {
+        *result_listener << "not carrying PaintReq at all.";
+        return false;
+    }
+
+    auto const& l_msg = l_event->get();
     *result_listener << "carrying PaintReq(" << l_msg.x << ", " << l_msg.y << ", " << l_msg.value << ")";
     return l_msg.x == p_x and l_msg.y == p_y and l_msg.value == p_value;
-} catch (std::bad_cast& l_exc) {
-    *result_listener << "not carrying PaintReq at all.";
-    return false;
+}
+
+MATCHER_P(DisplayBatchIndEq, p_cells, "")
+{
+    if (DisplayBatchInd::MESSAGE_ID != arg.getMessageId()) {
+        *result_listener << "not carrying DisplayBatchInd at all.";
+        return false;
+    }
+
+    auto const& l_cells = payload<DisplayBatchInd>(arg).cells;
+    *result_listener << "carrying DisplayBatchInd of " << l_cells.size() << " cells";
+    return std::equal(l_cells.begin(), l_cells.end(), p_cells.begin(), p_cells.end(),
+        [](auto const& l_lhs, auto const& l_rhs) {
+            return l_lhs.x == l_rhs.x and l_lhs.y == l_rhs.y and l_lhs.value == l_rhs.value;
+        });
 }
 
 MATCHER(AnyLooseInd, "")
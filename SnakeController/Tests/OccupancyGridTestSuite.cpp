@@ -0,0 +1,68 @@
+#include "OccupancyGrid.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+TEST(OccupancyGridTest, test_NewGrid_IsFree)
+{
+    OccupancyGrid grid(10, 10);
+
+    EXPECT_FALSE(grid.isOccupied(0, 0));
+    EXPECT_FALSE(grid.isOccupied(9, 9));
+}
+
+TEST(OccupancyGridTest, test_OccupyAndRelease_TogglesOnlyGivenCell)
+{
+    OccupancyGrid grid(100, 3);
+
+    grid.occupy(63, 0);
+    grid.occupy(64, 0);
+    EXPECT_TRUE(grid.isOccupied(63, 0));
+    EXPECT_TRUE(grid.isOccupied(64, 0));
+    EXPECT_FALSE(grid.isOccupied(63, 1));
+
+    grid.release(63, 0);
+    EXPECT_FALSE(grid.isOccupied(63, 0));
+    EXPECT_TRUE(grid.isOccupied(64, 0));
+}
+
+TEST(OccupancyGridTest, test_CellsOutsideMap_AreNeverOccupied)
+{
+    OccupancyGrid grid(10, 10);
+
+    grid.occupy(-1, 0);
+    grid.occupy(10, 0);
+
+    EXPECT_FALSE(grid.isOccupied(-1, 0));
+    EXPECT_FALSE(grid.isOccupied(10, 0));
+    EXPECT_FALSE(grid.isOccupied(0, 1));
+}
+
+TEST(OccupancyGridTest, test_MemoryUsage_IsOneBitPerCellRoundedToWords)
+{
+    EXPECT_EQ(8u, OccupancyGrid(8, 8).memoryUsage());
+    EXPECT_EQ(16u, OccupancyGrid(65, 1).memoryUsage());
+    EXPECT_EQ(80000u, OccupancyGrid(1000, 640).memoryUsage());
+}
+
+TEST(OccupancyGridTest, test_HugeMap_IsSparseAndSmall)
+{
+    OccupancyGrid grid(1 << 20, 1 << 20);
+    ASSERT_TRUE(grid.isSparse());
+
+    for (int x = 0; x < 1000; ++x) {
+        grid.occupy(500000 + x, 700000);
+    }
+    EXPECT_TRUE(grid.isOccupied(500999, 700000));
+    EXPECT_FALSE(grid.isOccupied(501000, 700000));
+    EXPECT_LT(grid.memoryUsage(), 64u * 1024u);
+
+    grid.release(500999, 700000);
+    EXPECT_FALSE(grid.isOccupied(500999, 700000));
+}
+
+} // namespace Snake
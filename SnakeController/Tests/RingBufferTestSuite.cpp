@@ -0,0 +1,56 @@
+#include "RingBuffer.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+TEST(RingBufferTest, test_PushFrontAndBack_KeepsOrderFromFront)
+{
+    RingBuffer<int> buffer;
+
+    buffer.push_back(2);
+    buffer.push_front(1);
+    buffer.push_back(3);
+
+    ASSERT_EQ(3u, buffer.size());
+    EXPECT_EQ(1, buffer.front());
+    EXPECT_EQ(2, buffer[1]);
+    EXPECT_EQ(3, buffer.back());
+}
+
+TEST(RingBufferTest, test_PopBack_RemovesFromBack)
+{
+    RingBuffer<int> buffer;
+    for (int i = 0; i < 5; ++i) {
+        buffer.push_back(i);
+    }
+
+    buffer.pop_back();
+    EXPECT_EQ(3, buffer.back());
+
+    buffer.pop_back(4);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferTest, test_GrowingWhileWrapped_PreservesElements)
+{
+    RingBuffer<int> buffer;
+    for (int i = 0; i < 10; ++i) {
+        buffer.push_back(i);
+    }
+    buffer.pop_back(10);
+
+    for (int i = 0; i < 100; ++i) {
+        buffer.push_front(i);
+    }
+
+    ASSERT_EQ(100u, buffer.size());
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(99 - i, buffer[i]);
+    }
+}
+
+} // namespace Snake
@@ -0,0 +1,119 @@
+#include "SnakeCodecs.hpp"
+
+#include <cstdio>
+
+#include "EventCodecRegistry.hpp"
+#include "EventJournal.hpp"
+#include "JournalReplay.hpp"
+#include "SnakeController.hpp"
+#include "WireFrame.hpp"
+
+#include <gtest/gtest.h>
+
+#include "Mocks/PortMock.hpp"
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+struct SnakeCodecsTest : Test
+{
+    SnakeCodecsTest() { registerSnakeCodecs(codecs); }
+
+    EventCodecRegistry codecs;
+};
+
+TEST_F(SnakeCodecsTest, test_DisplayBatchInd_RoundTrips)
+{
+    EventT<DisplayBatchInd> batch;
+    batch->cells = {{1, 2, Cell_FREE}, {3, 4, Cell_SNAKE}};
+
+    std::vector<std::uint8_t> bytes;
+    codecs.encode(batch, bytes);
+    auto const decoded = codecs.decode(DisplayBatchInd::MESSAGE_ID, bytes.data(), bytes.size());
+
+    auto const& cells = payload<DisplayBatchInd>(*decoded).cells;
+    ASSERT_EQ(2u, cells.size());
+    EXPECT_EQ(3, cells[1].x);
+    EXPECT_EQ(4, cells[1].y);
+    EXPECT_EQ(Cell_SNAKE, cells[1].value);
+}
+
+TEST_F(SnakeCodecsTest, test_AllMessages_StreamThroughWireFrames)
+{
+    std::vector<std::uint8_t> bytes;
+    encodeFrame(codecs, EventT<DirectionInd>(DirectionInd{Direction_LEFT}), bytes);
+    encodeFrame(codecs, EventT<TimeoutInd>(), bytes);
+    encodeFrame(codecs, EventT<DisplayInd>(DisplayInd{1, 2, Cell_FOOD}), bytes);
+    encodeFrame(codecs, EventT<FoodInd>(FoodInd{3, 4}), bytes);
+    encodeFrame(codecs, EventT<FoodReq>(), bytes);
+    encodeFrame(codecs, EventT<FoodResp>(FoodResp{5, 6}), bytes);
+    encodeFrame(codecs, EventT<ScoreInd>(), bytes);
+    encodeFrame(codecs, EventT<LooseInd>(), bytes);
+    encodeFrame(codecs, EventT<DisplayBatchInd>(DisplayBatchInd{{{7, 8, Cell_SNAKE}, {9, 10, Cell_FREE}}}), bytes);
+
+    WireFrameReader sut(bytes.data(), bytes.size());
+    WireFrameView frame;
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_EQ(Direction_LEFT, frame.as<DirectionInd>().direction);
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_TRUE(frame.is<TimeoutInd>());
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_EQ(Cell_FOOD, frame.as<DisplayInd>().value);
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_EQ(4, frame.as<FoodInd>().y);
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_TRUE(frame.is<FoodReq>());
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_EQ(5, frame.as<FoodResp>().x);
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_TRUE(frame.is<ScoreInd>());
+    ASSERT_TRUE(sut.next(frame));
+    EXPECT_TRUE(frame.is<LooseInd>());
+
+    ASSERT_TRUE(sut.next(frame));
+    ASSERT_TRUE(frame.is<DisplayBatchInd>());
+    ASSERT_EQ(2 * sizeof(DisplayInd), frame.payloadSize);
+    EXPECT_EQ(9, frame.read<DisplayInd>(sizeof(DisplayInd)).x);
+
+    EXPECT_FALSE(sut.next(frame));
+    EXPECT_EQ(bytes.size(), sut.consumed());
+}
+
+TEST_F(SnakeCodecsTest, test_JournaledGame_ReplaysWithoutMismatch)
+{
+    auto const path = ::testing::TempDir() + "snake_journal_test.bin";
+    std::string const config = "W 10 10 F 5 5 S R 3 2 1 1 1 0 1";
+    {
+        NiceMock<PortMock> sink;
+        EventJournal journal(path, codecs);
+        JournalingPort displayPort(journal, 1, sink);
+        JournalingPort foodPort(journal, 2, sink);
+        JournalingPort scorePort(journal, 3, sink);
+        Controller controller(displayPort, foodPort, scorePort, config);
+        JournalingEventHandler sut(journal, controller);
+
+        Direction const turns[] = {Direction_DOWN, Direction_RIGHT, Direction_UP, Direction_RIGHT};
+        for (int i = 0; i < 40; ++i) {
+            sut.receive(std::make_unique<EventT<TimeoutInd>>());
+            if (i % 3 == 0) {
+                sut.receive(std::make_unique<EventT<DirectionInd>>(DirectionInd{turns[(i / 3) % 4]}));
+            }
+            if (i % 7 == 0) {
+                sut.receive(std::make_unique<EventT<FoodResp>>(FoodResp{i % 10, (i / 3) % 10}));
+            }
+        }
+    }
+
+    EventJournalReader reader(path);
+    JournalReplay replay(reader, codecs);
+    Controller fresh(replay.port(1), replay.port(2), replay.port(3), config);
+    auto const result = replay.run(fresh);
+    std::remove(path.c_str());
+
+    EXPECT_GT(result.outputs, 0u);
+    EXPECT_EQ(0u, result.mismatches);
+}
+
+} // namespace Snake
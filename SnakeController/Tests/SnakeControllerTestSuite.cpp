@@ -1,7 +1,10 @@
 #include "SnakeController.hpp"
 
+#include "DisplayBatchAdapter.hpp"
 #include "EventT.hpp"
 
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include "Mocks/PortMock.hpp"
@@ -19,10 +22,11 @@ struct SnakeTest : Test
     StrictMock<PortMock> displayPortMock;
     StrictMock<PortMock> foodPortMock;
     StrictMock<PortMock> scorePortMock;
+    DisplayBatchAdapter displayPort{displayPortMock};
 
     void configureSUT(std::string p_config)
     {
-        sut = std::make_unique<Controller>(displayPortMock, foodPortMock, scorePortMock, p_config);
+        sut = std::make_unique<Controller>(displayPort, foodPortMock, scorePortMock, p_config);
     }
 
     std::unique_ptr<Controller> sut = nullptr;
@@ -53,6 +57,60 @@ TEST_F(SnakeTest, test_LackOfSnakeDirection_ThrowsException)
     EXPECT_THROW(configureSUT("W 100 100 F 50 50 S X"), ConfigurationError);
 }
 
+TEST_F(SnakeTest, test_NonPositiveMapDimension_ThrowsException)
+{
+    EXPECT_THROW(configureSUT("W 0 100 F 50 50 S U 1 20 20"), ConfigurationError);
+    EXPECT_THROW(configureSUT("W 100 -1 F 50 50 S U 1 20 20"), ConfigurationError);
+}
+
+TEST_F(SnakeTest, test_NonPositiveSnakeLength_ThrowsException)
+{
+    EXPECT_THROW(configureSUT("W 100 100 F 50 50 S U 0"), ConfigurationError);
+    EXPECT_THROW(configureSUT("W 100 100 F 50 50 S U -3 20 20"), ConfigurationError);
+}
+
+TEST_F(SnakeTest, test_TruncatedSegmentList_ThrowsExceptionAtEndOfConfig)
+{
+    std::string const config = "W 100 100 F 50 50 S U 3 20 20 20 21 20";
+    try {
+        configureSUT(config);
+        FAIL() << "ConfigurationError expected";
+    } catch (ConfigurationError const& error) {
+        EXPECT_EQ(config.size(), error.offset);
+    }
+}
+
+TEST_F(SnakeTest, test_SegmentOutsideMap_ThrowsExceptionAtSegment)
+{
+    try {
+        configureSUT("W 100 100 F 50 50 S U 2 20 20 20 100");
+        FAIL() << "ConfigurationError expected";
+    } catch (ConfigurationError const& error) {
+        EXPECT_EQ(29u, error.offset);
+    }
+}
+
+TEST_F(SnakeTest, test_OverlappingOrDetachedSegment_ThrowsExceptionAtSegment)
+{
+    try {
+        configureSUT("W 100 100 F 50 50 S U 3 20 20 20 21 20 20");
+        FAIL() << "ConfigurationError expected";
+    } catch (ConfigurationError const& error) {
+        EXPECT_EQ(35u, error.offset);
+    }
+    try {
+        configureSUT("W 100 100 F 50 50 S U 2 20 20 22 20");
+        FAIL() << "ConfigurationError expected";
+    } catch (ConfigurationError const& error) {
+        EXPECT_EQ(29u, error.offset);
+    }
+}
+
+TEST_F(SnakeTest, test_TrailingData_ThrowsException)
+{
+    EXPECT_THROW(configureSUT("W 100 100 F 50 50 S U 1 20 20 X"), ConfigurationError);
+}
+
 TEST_F(SnakeTest, test_UnexpectedEvent_ThrowsException)
 {
     configureSUT("W 100 100 F 50 50 S U 1 20 20");
@@ -279,6 +337,57 @@ TEST_F(SnakeEatTestSuite, test_ReceiveFoodRespDetectsCollision_ThenRequestNewFoo
     sut->receive(std::make_unique<EventT<FoodResp>>(l_foodResp));
 }
 
+TEST_F(SnakeTest, test_HugeMap_WorksWithoutDenseStorage)
+{
+    configureSUT("W 2147483647 2147483647 F 5 5 S R 2 2147483000 1000000000 2147482999 1000000000");
+
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(2147482999, 1000000000, Cell_FREE)));
+    EXPECT_CALL(displayPortMock, send_rvr(DisplayIndEq(2147483001, 1000000000, Cell_SNAKE)));
+
+    sut->receive(te.clone());
+}
+
+struct SnakeDisplayBatchTest : SnakeTest
+{
+    StrictMock<PortMock> batchPortMock;
+
+    void SetUp() override
+    {
+        sut = std::make_unique<Controller>(batchPortMock, foodPortMock, scorePortMock, "W 100 100 F 50 50 S R 1 20 20");
+    }
+};
+
+TEST_F(SnakeDisplayBatchTest, test_Tick_SendsAllCellChangesInOneBatch)
+{
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {20, 20, Cell_FREE},
+        {21, 20, Cell_SNAKE}})));
+
+    sut->receive(te.clone());
+}
+
+TEST_F(SnakeDisplayBatchTest, test_ReceiveFoodInd_SendsClearAndPlaceInOneBatch)
+{
+    FoodInd l_foodInd;
+    l_foodInd.x = 30;
+    l_foodInd.y = 30;
+
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {50, 50, Cell_FREE},
+        {30, 30, Cell_FOOD}})));
+
+    sut->receive(std::make_unique<EventT<FoodInd>>(l_foodInd));
+}
+
+TEST_F(SnakeDisplayBatchTest, test_LosingTick_SendsNoDisplayBatch)
+{
+    sut = std::make_unique<Controller>(batchPortMock, foodPortMock, scorePortMock, "W 100 100 F 50 50 S R 1 99 20");
+
+    EXPECT_CALL(scorePortMock, send_rvr(AnyLooseInd()));
+
+    sut->receive(te.clone());
+}
+
 struct SnakeNewFoodTest : SnakeTest
 {
     void SetUp() override
@@ -310,4 +419,281 @@ TEST_F(SnakeNewFoodTest, test_ReceiveFoodIndDetectsCollision_ThenRequestNewFood)
     sut->receive(std::make_unique<EventT<FoodInd>>(l_foodInd));
 }
 
+struct SnakeFoodPlacementTest : SnakeDisplayBatchTest
+{
+    // The maps below leave at most one free cell, so placement does not depend on the seed.
+    void configure(std::string p_config)
+    {
+        sut = std::make_unique<Controller>(batchPortMock, foodPortMock, scorePortMock, p_config);
+        sut->enableFoodPlacement(1);
+    }
+};
+
+TEST_F(SnakeFoodPlacementTest, test_EatingFood_PlacesNewFoodWithoutRequest)
+{
+    configure("W 3 1 F 1 0 S R 1 0 0");
+
+    EXPECT_CALL(scorePortMock, send_rvr(AnyScoreInd()));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {1, 0, Cell_SNAKE},
+        {2, 0, Cell_FOOD}})));
+
+    sut->receive(te.clone());
+}
+
+TEST_F(SnakeFoodPlacementTest, test_ReceiveFoodIndDetectsCollision_ThenPlacesFoodItself)
+{
+    configure("W 3 1 F 2 0 S R 2 1 0 0 0");
+
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {2, 0, Cell_FREE},
+        {2, 0, Cell_FOOD}})));
+
+    sut->receive(std::make_unique<EventT<FoodInd>>(FoodInd{0, 0}));
+}
+
+TEST_F(SnakeFoodPlacementTest, test_ReceiveFoodRespDetectsCollision_ThenPlacesFoodItself)
+{
+    configure("W 3 1 F 2 0 S R 2 1 0 0 0");
+
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {2, 0, Cell_FREE},
+        {2, 0, Cell_FOOD}})));
+
+    sut->receive(std::make_unique<EventT<FoodResp>>(FoodResp{1, 0}));
+}
+
+TEST_F(SnakeFoodPlacementTest, test_FullBoard_PlacesNoFood)
+{
+    configure("W 2 1 F 1 0 S R 1 0 0");
+
+    EXPECT_CALL(scorePortMock, send_rvr(AnyScoreInd()));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{{1, 0, Cell_SNAKE}})));
+
+    sut->receive(te.clone());
+}
+
+TEST_F(SnakeFoodPlacementTest, test_FoodIndOnFullBoard_ClearsNoCellOffTheMap)
+{
+    configure("W 2 1 F 1 0 S R 1 0 0");
+    EXPECT_CALL(scorePortMock, send_rvr(AnyScoreInd()));
+    EXPECT_CALL(batchPortMock, send_rvr(_));
+    sut->receive(te.clone());
+
+    EXPECT_CALL(batchPortMock, send_rvr(_)).Times(0);
+    sut->receive(std::make_unique<EventT<FoodInd>>(FoodInd{0, 0}));
+}
+
+TEST_F(SnakeFoodPlacementTest, test_FoodIndOnFreeCellAfterFullBoard_ClearsNoCellOffTheMap)
+{
+    configure("W 2 1 F 1 0 S R 1 0 0");
+    EXPECT_CALL(scorePortMock, send_rvr(AnyScoreInd()));
+    EXPECT_CALL(batchPortMock, send_rvr(_));
+    sut->receive(te.clone());
+
+    // The board is full, so only a cell off the map is free.
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{{2, 0, Cell_FOOD}})));
+    sut->receive(std::make_unique<EventT<FoodInd>>(FoodInd{2, 0}));
+}
+
+struct SnakeAdvanceTest : SnakeDisplayBatchTest
+{
+    void configure(std::string p_config)
+    {
+        sut = std::make_unique<Controller>(batchPortMock, foodPortMock, scorePortMock, p_config);
+    }
+};
+
+TEST_F(SnakeAdvanceTest, test_AdvanceWithoutDisplay_MovesSnakeSilently)
+{
+    configure("W 100 100 F 50 50 S R 1 20 20");
+
+    auto const result = sut->advance(5);
+    EXPECT_EQ(5u, result.ticks);
+    EXPECT_EQ(Tick_MOVED, result.outcome);
+
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {25, 20, Cell_FREE},
+        {26, 20, Cell_SNAKE}})));
+    sut->receive(te.clone());
+}
+
+TEST_F(SnakeAdvanceTest, test_AdvanceWithNetDisplay_SendsOnlyChangedCells)
+{
+    configure("W 100 100 F 50 50 S R 3 20 20 19 20 18 20");
+
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {18, 20, Cell_FREE},
+        {19, 20, Cell_FREE},
+        {20, 20, Cell_FREE},
+        {22, 20, Cell_SNAKE},
+        {23, 20, Cell_SNAKE},
+        {24, 20, Cell_SNAKE}})));
+
+    sut->advance(4, AdvanceDisplay_NET);
+}
+
+TEST_F(SnakeAdvanceTest, test_Advance_StopsAfterEating)
+{
+    configure("W 100 100 F 23 20 S R 1 20 20");
+
+    EXPECT_CALL(scorePortMock, send_rvr(AnyScoreInd()));
+    EXPECT_CALL(foodPortMock, send_rvr(AnyFoodReq()));
+
+    auto const result = sut->advance(10);
+    EXPECT_EQ(3u, result.ticks);
+    EXPECT_EQ(Tick_ATE, result.outcome);
+}
+
+TEST_F(SnakeAdvanceTest, test_Advance_StopsAfterLoosing)
+{
+    configure("W 100 100 F 50 50 S R 1 97 20");
+
+    EXPECT_CALL(scorePortMock, send_rvr(AnyLooseInd()));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {97, 20, Cell_FREE},
+        {99, 20, Cell_SNAKE}})));
+
+    auto const result = sut->advance(10, AdvanceDisplay_NET);
+    EXPECT_EQ(3u, result.ticks);
+    EXPECT_EQ(Tick_LOST, result.outcome);
+}
+
+TEST_F(SnakeAdvanceTest, test_Advance_LeavesSameStateAsTimeouts)
+{
+    NiceMock<PortMock> l_displayPort{};
+    NiceMock<PortMock> l_foodPort{};
+    NiceMock<PortMock> l_scorePort{};
+    std::string const l_config = "W 100 100 F 50 50 S D 6 20 20 21 20 22 20 23 20 24 20 25 20";
+    Controller l_ticked(l_displayPort, l_foodPort, l_scorePort, l_config);
+    Controller l_advanced(l_displayPort, l_foodPort, l_scorePort, l_config);
+
+    for (int i = 0; i < 30; ++i) {
+        l_ticked.receive(te.clone());
+    }
+    l_advanced.advance(30, AdvanceDisplay_NET);
+
+    EXPECT_EQ(l_ticked.saveSnapshot(), l_advanced.saveSnapshot());
+}
+
+TEST_F(SnakeAdvanceTest, test_AdvanceWithNetDisplay_EndsWithPlacedFood)
+{
+    configure("W 3 1 F 1 0 S R 1 0 0");
+    sut->enableFoodPlacement(1);
+
+    EXPECT_CALL(scorePortMock, send_rvr(AnyScoreInd()));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {1, 0, Cell_SNAKE},
+        {2, 0, Cell_FOOD}})));
+
+    sut->advance(10, AdvanceDisplay_NET);
+}
+
+struct SnakeBatchTest : SnakeDisplayBatchTest
+{
+    std::vector<std::unique_ptr<Event>> batch;
+
+    template <class T>
+    void add(T const& p_message)
+    {
+        batch.push_back(std::make_unique<EventT<T>>(p_message));
+    }
+};
+
+TEST_F(SnakeBatchTest, test_Ticks_SendOneDisplayBatch)
+{
+    add(TimeoutInd{});
+    add(TimeoutInd{});
+    add(DirectionInd{Direction_UP});
+    add(DirectionInd{Direction_LEFT});
+    add(DirectionInd{Direction_DOWN});
+    add(TimeoutInd{});
+
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {20, 20, Cell_FREE},
+        {21, 20, Cell_SNAKE},
+        {21, 20, Cell_FREE},
+        {22, 20, Cell_SNAKE}})));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {22, 20, Cell_FREE},
+        {22, 21, Cell_SNAKE}})));
+
+    sut->receiveBatch(batch.data(), batch.size());
+}
+
+TEST_F(SnakeBatchTest, test_FoodUpdatesAfterEating_SendSameAsOneByOne)
+{
+    sut = std::make_unique<Controller>(batchPortMock, foodPortMock, scorePortMock, "W 100 100 F 21 20 S R 1 20 20");
+    EXPECT_CALL(scorePortMock, send_rvr(AnyScoreInd()));
+    EXPECT_CALL(foodPortMock, send_rvr(AnyFoodReq()));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{{21, 20, Cell_SNAKE}})));
+    sut->receive(te.clone());
+
+    add(FoodResp{20, 20});
+    add(FoodResp{30, 30});
+    add(FoodInd{40, 40});
+
+    InSequence l_inOrder;
+    EXPECT_CALL(foodPortMock, send_rvr(AnyFoodReq()));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{{30, 30, Cell_FOOD}})));
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {30, 30, Cell_FREE},
+        {40, 40, Cell_FOOD}})));
+
+    sut->receiveBatch(batch.data(), batch.size());
+}
+
+TEST_F(SnakeBatchTest, test_UnexpectedEvent_ThrowsAfterEarlierEvents)
+{
+    add(TimeoutInd{});
+    add(ScoreInd{});
+    add(TimeoutInd{});
+
+    EXPECT_CALL(batchPortMock, send_rvr(DisplayBatchIndEq(std::vector<DisplayInd>{
+        {20, 20, Cell_FREE},
+        {21, 20, Cell_SNAKE}})));
+
+    EXPECT_THROW(sut->receiveBatch(batch.data(), batch.size()), UnexpectedEventException);
+    EXPECT_EQ(nullptr, batch[0]);
+    EXPECT_EQ(nullptr, batch[1]);
+    EXPECT_NE(nullptr, batch[2]);
+}
+
+TEST_F(SnakeBatchTest, test_RandomBatches_LeaveSameStateAsOneByOne)
+{
+    NiceMock<PortMock> l_displayPort{};
+    NiceMock<PortMock> l_foodPort{};
+    NiceMock<PortMock> l_scorePort{};
+    std::string const l_config = "W 40 40 F 30 30 S R 4 20 20 19 20 18 20 17 20";
+    Controller l_oneByOne(l_displayPort, l_foodPort, l_scorePort, l_config);
+    Controller l_batched(l_displayPort, l_foodPort, l_scorePort, l_config);
+
+    std::mt19937 l_random(5);
+    std::uniform_int_distribution<int> l_kind(0, 9), l_cell(0, 39), l_size(1, 40);
+    Direction const l_directions[] = {Direction_UP, Direction_DOWN, Direction_LEFT, Direction_RIGHT};
+
+    for (int l_round = 0; l_round < 50; ++l_round) {
+        batch.clear();
+        for (int i = l_size(l_random); i > 0; --i) {
+            auto const l_which = l_kind(l_random);
+            if (l_which < 5) {
+                add(TimeoutInd{});
+            } else if (l_which < 8) {
+                add(DirectionInd{l_directions[l_random() % 4]});
+            } else if (l_which == 8) {
+                add(FoodInd{l_cell(l_random), l_cell(l_random)});
+            } else {
+                add(FoodResp{l_cell(l_random), l_cell(l_random)});
+            }
+        }
+
+        for (auto const& l_event : batch) {
+            l_oneByOne.receive(l_event->clone());
+        }
+        l_batched.receiveBatch(batch.data(), batch.size());
+
+        ASSERT_EQ(l_oneByOne.saveSnapshot(), l_batched.saveSnapshot());
+    }
+}
+
 } // namespace Snake
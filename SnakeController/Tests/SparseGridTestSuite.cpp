@@ -0,0 +1,86 @@
+#include "SparseGrid.hpp"
+
+#include <climits>
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+TEST(SparseGridTest, test_UntouchedCells_HoldDefault)
+{
+    SparseGrid<int> grid;
+
+    EXPECT_EQ(0, grid.get(0, 0));
+    EXPECT_EQ(0, grid.get(INT_MAX, INT_MAX));
+    EXPECT_EQ(0u, grid.chunkCount());
+}
+
+TEST(SparseGridTest, test_SetAndGet_FarApartCells)
+{
+    SparseGrid<int> grid;
+
+    grid.set(3, 4, 7);
+    grid.set(INT_MAX, INT_MAX, 9);
+    grid.set(4, 4, 8);
+
+    EXPECT_EQ(7, grid.get(3, 4));
+    EXPECT_EQ(8, grid.get(4, 4));
+    EXPECT_EQ(9, grid.get(INT_MAX, INT_MAX));
+    EXPECT_EQ(0, grid.get(3, 5));
+    EXPECT_EQ(2u, grid.chunkCount());
+}
+
+TEST(SparseGridTest, test_ResettingAllCellsOfChunk_FreesIt)
+{
+    SparseGrid<bool> grid;
+
+    grid.set(10, 10, true);
+    grid.set(11, 10, true);
+    grid.set(10, 10, false);
+    EXPECT_EQ(1u, grid.chunkCount());
+
+    grid.set(11, 10, false);
+    EXPECT_EQ(0u, grid.chunkCount());
+    EXPECT_FALSE(grid.get(11, 10));
+}
+
+TEST(SparseGridTest, test_ForEach_VisitsSetCells)
+{
+    SparseGrid<int> grid;
+    grid.set(1, 2, 5);
+    grid.set(1000, 2000, 6);
+
+    std::map<std::pair<int, int>, int> visited;
+    grid.forEach([&](int p_x, int p_y, int p_value) { visited[{p_x, p_y}] = p_value; });
+
+    std::map<std::pair<int, int>, int> const expected = {{{1, 2}, 5}, {{1000, 2000}, 6}};
+    EXPECT_EQ(expected, visited);
+}
+
+TEST(SparseGridTest, test_RandomUpdates_MatchReferenceMap)
+{
+    SparseGrid<int> grid;
+    std::map<std::pair<int, int>, int> reference;
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> coordinate(0, 200);
+    std::uniform_int_distribution<int> value(0, 3);
+
+    for (int i = 0; i < 20000; ++i) {
+        auto const x = coordinate(random);
+        auto const y = coordinate(random);
+        auto const v = value(random);
+        grid.set(x, y, v);
+        reference[{x, y}] = v;
+    }
+
+    for (auto const& [cell, v] : reference) {
+        ASSERT_EQ(v, grid.get(cell.first, cell.second));
+    }
+}
+
+} // namespace Snake
@@ -0,0 +1,118 @@
+#include "TickBatch.hpp"
+
+#include <cstring>
+#include <random>
+
+#include "EventT.hpp"
+
+#include <gtest/gtest.h>
+
+#include "Mocks/PortMock.hpp"
+
+using namespace ::testing;
+
+namespace Snake
+{
+
+struct TickBatchTest : Test
+{
+    NiceMock<PortMock> portMock;
+    std::vector<std::vector<std::uint8_t>> snapshots;
+
+    std::unique_ptr<Controller> makeController(std::string const& p_config)
+    {
+        return std::make_unique<Controller>(portMock, portMock, portMock, p_config);
+    }
+
+    SnapshotView snapshotOf(Controller const& p_controller)
+    {
+        snapshots.push_back(p_controller.saveSnapshot());
+        return SnapshotView{snapshots.back().data(), snapshots.back().size()};
+    }
+
+    void checkAgainstControllers(TickKernel p_kernel);
+};
+
+TEST_F(TickBatchTest, test_Tick_ReportsMovesFoodAndWalls)
+{
+    TickBatch sut;
+    auto const moving = sut.addGame(snapshotOf(*makeController("W 10 10 F 7 7 S R 2 2 2 1 2")));
+    auto const eating = sut.addGame(snapshotOf(*makeController("W 10 10 F 3 2 S R 2 2 2 1 2")));
+    auto const walled = sut.addGame(snapshotOf(*makeController("W 10 10 F 7 7 S U 2 2 0 2 1")));
+
+    auto const& outcomes = sut.tick();
+
+    EXPECT_EQ(Tick_MOVED, outcomes[moving]);
+    EXPECT_EQ(Tick_ATE, outcomes[eating]);
+    EXPECT_EQ(Tick_LOST, outcomes[walled]);
+}
+
+TEST_F(TickBatchTest, test_AddGame_RejectsBrokenSnapshot)
+{
+    TickBatch sut;
+    auto snapshot = makeController("W 10 10 F 7 7 S R 2 2 2 1 2")->saveSnapshot();
+    snapshot.pop_back();
+
+    EXPECT_THROW(sut.addGame(SnapshotView{snapshot.data(), snapshot.size()}), ConfigurationError);
+    EXPECT_EQ(0u, sut.size());
+}
+
+TEST_F(TickBatchTest, test_Tick_MatchesControllersOverRandomGames)
+{
+    checkAgainstControllers(TickKernel_AUTO);
+}
+
+TEST_F(TickBatchTest, test_ScalarTick_MatchesControllersOverRandomGames)
+{
+    checkAgainstControllers(TickKernel_SCALAR);
+}
+
+void TickBatchTest::checkAgainstControllers(TickKernel p_kernel)
+{
+    std::mt19937 random(1234);
+    auto const pick = [&random](int p_bound) { return std::uniform_int_distribution<int>(0, p_bound - 1)(random); };
+
+    // Small maps and long snakes, so that walls, food and bodies all get hit; not a whole number
+    // of vectors, so that the padding is covered too. Games that lost go on being ticked, as a
+    // Controller would be, and may change direction and move again.
+    TickBatch sut(p_kernel);
+    std::vector<std::unique_ptr<Controller>> controllers;
+    for (int i = 0; i < 37; ++i) {
+        auto const width = 6 + pick(4);
+        auto const height = 6 + pick(4);
+        auto const y = pick(height);
+        controllers.push_back(makeController(
+            "W " + std::to_string(width) + " " + std::to_string(height) +
+            " F " + std::to_string(pick(width)) + " " + std::to_string(pick(height)) +
+            " S R 4 3 " + std::to_string(y) + " 2 " + std::to_string(y) + " 1 " + std::to_string(y) +
+            " 0 " + std::to_string(y)));
+        sut.addGame(snapshotOf(*controllers.back()));
+    }
+
+    for (int tick = 0; tick < 40; ++tick) {
+        for (std::size_t i = 0; i < controllers.size(); ++i) {
+            if (pick(3) == 0) {
+                auto const direction = static_cast<Direction>(pick(4));
+                controllers[i]->receive(std::make_unique<EventT<DirectionInd>>(DirectionInd{direction}));
+                sut.setDirection(i, direction);
+            }
+            if (pick(4) == 0) {
+                // Next to the head, or off the map now and then, to get eaten often enough.
+                SnapshotSegment head;
+                std::memcpy(&head, sut.saveSnapshot(i).data() + sizeof(SnapshotHeader), sizeof(head));
+                auto const x = head.x + pick(3) - 1;
+                auto const y = head.y + pick(3) - 1;
+                controllers[i]->receive(std::make_unique<EventT<FoodInd>>(FoodInd{x, y}));
+                sut.setFood(i, x, y);
+            }
+        }
+
+        auto const& outcomes = sut.tick();
+        for (std::size_t i = 0; i < controllers.size(); ++i) {
+            ASSERT_EQ(controllers[i]->advance(1).outcome, outcomes[i]) << "game " << i << ", tick " << tick;
+            ASSERT_EQ(controllers[i]->saveSnapshot(), sut.saveSnapshot(i)) << "game " << i << ", tick " << tick;
+        }
+    }
+}
+
+} // namespace Snake
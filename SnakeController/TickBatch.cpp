@@ -0,0 +1,239 @@
+#include "TickBatch.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__))
+#include <immintrin.h>
+#define SNAKE_TICK_BATCH_AVX2 1
+#endif
+
+namespace Snake
+{
+namespace
+{
+
+constexpr std::size_t LANES = 8;
+constexpr std::size_t PREFETCH_DISTANCE = 8;
+
+struct Lanes
+{
+    std::int32_t const* headX;
+    std::int32_t const* headY;
+    std::int32_t const* direction;
+    std::int32_t const* width;
+    std::int32_t const* height;
+    std::int32_t const* foodX;
+    std::int32_t const* foodY;
+    std::int32_t* nextX;
+    std::int32_t* nextY;
+    std::uint8_t* foodHits;
+    std::uint8_t* wallHits;
+};
+
+// The step is +1 or -1 as bit 1 of the direction is set or not, along x when bit 0 is set.
+void aimScalar(Lanes const& p_lanes, std::size_t p_count)
+{
+    for (std::size_t block = 0; block < p_count; block += LANES) {
+        std::uint8_t food = 0;
+        std::uint8_t wall = 0;
+        for (std::size_t lane = 0; lane < LANES; ++lane) {
+            auto const i = block + lane;
+            auto const direction = p_lanes.direction[i];
+            auto const step = (direction & 0b10) - 1;
+            auto const x = p_lanes.headX[i] + ((direction & 0b01) ? step : 0);
+            auto const y = p_lanes.headY[i] + ((direction & 0b01) ? 0 : step);
+            p_lanes.nextX[i] = x;
+            p_lanes.nextY[i] = y;
+            food |= static_cast<std::uint8_t>((x == p_lanes.foodX[i] and y == p_lanes.foodY[i]) << lane);
+            wall |= static_cast<std::uint8_t>((x < 0 or y < 0 or x >= p_lanes.width[i] or y >= p_lanes.height[i]) << lane);
+        }
+        p_lanes.foodHits[block / LANES] = food;
+        p_lanes.wallHits[block / LANES] = wall;
+    }
+}
+
+#ifdef SNAKE_TICK_BATCH_AVX2
+__attribute__((target("avx2"), always_inline)) inline __m256i load(std::int32_t const* p_from)
+{
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p_from));
+}
+
+__attribute__((target("avx2"))) void aimAvx2(Lanes const& p_lanes, std::size_t p_count)
+{
+    auto const one = _mm256_set1_epi32(1);
+    auto const two = _mm256_set1_epi32(2);
+    auto const zero = _mm256_setzero_si256();
+
+    for (std::size_t block = 0; block < p_count; block += LANES) {
+        auto const direction = load(p_lanes.direction + block);
+        auto const step = _mm256_sub_epi32(_mm256_and_si256(direction, two), one);
+        auto const alongX = _mm256_cmpeq_epi32(_mm256_and_si256(direction, one), one);
+
+        auto const x = _mm256_add_epi32(load(p_lanes.headX + block), _mm256_and_si256(step, alongX));
+        auto const y = _mm256_add_epi32(load(p_lanes.headY + block), _mm256_andnot_si256(alongX, step));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_lanes.nextX + block), x);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p_lanes.nextY + block), y);
+
+        auto const food = _mm256_and_si256(_mm256_cmpeq_epi32(x, load(p_lanes.foodX + block)),
+                                           _mm256_cmpeq_epi32(y, load(p_lanes.foodY + block)));
+        auto const inside = _mm256_and_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi32(load(p_lanes.width + block), x),
+                             _mm256_cmpgt_epi32(load(p_lanes.height + block), y)),
+            _mm256_cmpgt_epi32(_mm256_min_epi32(x, y), _mm256_set1_epi32(-1)));
+
+        p_lanes.foodHits[block / LANES] = static_cast<std::uint8_t>(_mm256_movemask_ps(_mm256_castsi256_ps(food)));
+        p_lanes.wallHits[block / LANES] = static_cast<std::uint8_t>(
+            _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(inside, zero))));
+    }
+}
+#endif
+
+bool cpuHasAvx2() noexcept
+{
+#ifdef SNAKE_TICK_BATCH_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+TickBatch::TickBatch(TickKernel p_kernel)
+    : m_avx2(p_kernel == TickKernel_AUTO and cpuHasAvx2())
+{}
+
+std::size_t TickBatch::addGame(SnapshotView p_snapshot)
+{
+    auto const header = readSnapshotHeader(p_snapshot);
+
+    Game game{{}, OccupancyGrid(header.width, header.height)};
+    auto const count = static_cast<std::size_t>(header.segmentCount);
+    auto const segments = game.segments.assign(count);
+    std::memcpy(segments, static_cast<char const*>(p_snapshot.data) + sizeof(SnapshotHeader),
+                count * sizeof(SnapshotSegment));
+    occupySnapshotSegments(p_snapshot, header, game.occupancy);
+
+    auto const index = m_games.size();
+    if (index % LANES == 0) {
+        for (auto* lane : {&m_headX, &m_headY, &m_direction, &m_width, &m_height, &m_foodX, &m_foodY, &m_nextX, &m_nextY}) {
+            lane->resize(index + LANES);
+        }
+        m_moves.resize(index + LANES);
+        m_foodHits.push_back(0);
+        m_wallHits.push_back(0);
+    }
+
+    m_headX[index] = segments[0].x;
+    m_headY[index] = segments[0].y;
+    m_direction[index] = static_cast<std::int32_t>(header.direction);
+    m_width[index] = header.width;
+    m_height[index] = header.height;
+    m_foodX[index] = header.foodX;
+    m_foodY[index] = header.foodY;
+    m_moves[index] = header.moves;
+
+    m_games.push_back(std::move(game));
+    m_outcomes.push_back(Tick_MOVED);
+    return index;
+}
+
+void TickBatch::setDirection(std::size_t p_game, Direction p_direction)
+{
+    auto& direction = m_direction.at(p_game);
+    if ((direction & 0b01) != (p_direction & 0b01)) {
+        direction = p_direction;
+    }
+}
+
+void TickBatch::setFood(std::size_t p_game, int p_x, int p_y)
+{
+    m_foodX.at(p_game) = p_x;
+    m_foodY.at(p_game) = p_y;
+}
+
+std::vector<TickOutcome> const& TickBatch::tick()
+{
+    Lanes const lanes{m_headX.data(), m_headY.data(), m_direction.data(), m_width.data(), m_height.data(),
+                      m_foodX.data(), m_foodY.data(), m_nextX.data(), m_nextY.data(),
+                      m_foodHits.data(), m_wallHits.data()};
+#ifdef SNAKE_TICK_BATCH_AVX2
+    if (m_avx2) {
+        aimAvx2(lanes, m_headX.size());
+    } else
+#endif
+    {
+        aimScalar(lanes, m_headX.size());
+    }
+
+    // The same order of checks as Controller::tick(): own body, then food, then walls. Games are
+    // independent, so the memory of those coming next is requested while this one is worked on:
+    // first the Game itself, then, once it is there, its cells and segments.
+    for (std::size_t i = 0; i < m_games.size(); ++i) {
+        if (i + 2 * PREFETCH_DISTANCE < m_games.size()) {
+            __builtin_prefetch(&m_games[i + 2 * PREFETCH_DISTANCE]);
+        }
+        if (i + PREFETCH_DISTANCE < m_games.size()) {
+            auto const& ahead = m_games[i + PREFETCH_DISTANCE];
+            ahead.occupancy.prefetch(m_nextX[i + PREFETCH_DISTANCE], m_nextY[i + PREFETCH_DISTANCE]);
+            ahead.segments.prefetchEnds();
+        }
+
+        auto& game = m_games[i];
+        auto const x = m_nextX[i];
+        auto const y = m_nextY[i];
+        bool const food = (m_foodHits[i / LANES] >> (i % LANES)) & 1;
+        bool const wall = (m_wallHits[i / LANES] >> (i % LANES)) & 1;
+
+        if (game.occupancy.isOccupied(x, y) or (wall and not food)) {
+            m_outcomes[i] = Tick_LOST;
+            continue;
+        }
+
+        SnapshotSegment head{x, y, game.segments.front().releaseAt};
+        if (food) {
+            m_outcomes[i] = Tick_ATE;
+        } else {
+            m_outcomes[i] = Tick_MOVED;
+            auto const moves = ++m_moves[i];
+            ++head.releaseAt;
+            while (not game.segments.empty() and game.segments.back().releaseAt <= moves) {
+                game.occupancy.release(game.segments.back().x, game.segments.back().y);
+                game.segments.pop_back();
+            }
+        }
+
+        game.segments.push_front(head);
+        game.occupancy.occupy(x, y);
+        m_headX[i] = x;
+        m_headY[i] = y;
+    }
+    return m_outcomes;
+}
+
+std::vector<std::uint8_t> TickBatch::saveSnapshot(std::size_t p_game) const
+{
+    auto const& game = m_games.at(p_game);
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SnapshotHeader::MAGIC, sizeof(header.magic));
+    header.version = SnapshotHeader::VERSION;
+    header.width = m_width[p_game];
+    header.height = m_height[p_game];
+    header.foodX = m_foodX[p_game];
+    header.foodY = m_foodY[p_game];
+    header.direction = static_cast<std::uint32_t>(m_direction[p_game]);
+    header.reserved = 0;
+    header.moves = m_moves[p_game];
+    header.segmentCount = game.segments.size();
+
+    std::vector<std::uint8_t> snapshot(sizeof(SnapshotHeader) + game.segments.size() * sizeof(SnapshotSegment));
+    std::memcpy(snapshot.data(), &header, sizeof(header));
+    for (std::size_t i = 0; i < game.segments.size(); ++i) {
+        std::memcpy(snapshot.data() + sizeof(SnapshotHeader) + i * sizeof(SnapshotSegment), &game.segments[i],
+                    sizeof(SnapshotSegment));
+    }
+    return snapshot;
+}
+
+} // namespace Snake
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ControllerSnapshot.hpp"
+#include "OccupancyGrid.hpp"
+#include "RingBuffer.hpp"
+#include "SnakeController.hpp"
+#include "SnakeInterface.hpp"
+
+namespace Snake
+{
+
+enum TickKernel
+{
+    TickKernel_AUTO,   // AVX2 when the CPU has it, scalar otherwise
+    TickKernel_SCALAR
+};
+
+// Many games ticked together, each ending up exactly where a Controller receiving the same
+// TimeoutInd and DirectionInd would. Head, direction, map bounds and food position sit in one
+// array each, so the new heads and their wall and food hits come out of a single vector pass over
+// all games; only the checks against each snake's own body and the moves themselves are left to
+// scalar code, game by game.
+class TickBatch
+{
+public:
+    explicit TickBatch(TickKernel p_kernel = TickKernel_AUTO);
+
+    // Takes a game in the state of a Controller snapshot; returns its index.
+    std::size_t addGame(SnapshotView p_snapshot);
+
+    std::size_t size() const noexcept { return m_games.size(); }
+    bool usesAvx2() const noexcept { return m_avx2; }
+
+    // As DirectionInd: ignored when reversing the snake onto itself.
+    void setDirection(std::size_t p_game, Direction p_direction);
+
+    // Moves the food of a game, as FoodInd or FoodResp do to the controller state.
+    void setFood(std::size_t p_game, int p_x, int p_y);
+
+    // One TimeoutInd for every game. Each outcome is what Controller::advance(1) would return:
+    // Tick_ATE goes with ScoreInd and FoodReq, Tick_LOST with LooseInd.
+    std::vector<TickOutcome> const& tick();
+
+    std::vector<std::uint8_t> saveSnapshot(std::size_t p_game) const;
+
+private:
+    struct Game
+    {
+        RingBuffer<SnapshotSegment> segments; // head first
+        OccupancyGrid occupancy;
+    };
+
+    bool m_avx2;
+    std::vector<Game> m_games;
+    std::vector<TickOutcome> m_outcomes;
+
+    // One entry per game, padded to whole vectors.
+    std::vector<std::int32_t> m_headX;
+    std::vector<std::int32_t> m_headY;
+    std::vector<std::int32_t> m_direction;
+    std::vector<std::int32_t> m_width;
+    std::vector<std::int32_t> m_height;
+    std::vector<std::int32_t> m_foodX;
+    std::vector<std::int32_t> m_foodY;
+    std::vector<std::int32_t> m_nextX;
+    std::vector<std::int32_t> m_nextY;
+    std::vector<std::uint64_t> m_moves;
+    std::vector<std::uint8_t> m_foodHits; // one bit per game
+    std::vector<std::uint8_t> m_wallHits;
+};
+
+} // namespace Snake